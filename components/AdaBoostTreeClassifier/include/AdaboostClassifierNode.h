@@ -51,25 +51,149 @@
 
 #include <AdaboostClassifier.h>
 #include <AdaboostClassifierNodeParams.h>
+#include <AdaboostModelRegistry.h>
 
 namespace mira {
 namespace adaboosttreeclassifier {
 
+/**
+ * the margins of the nodes of a tree for one sample, without the thresholds of the nodes
+ * every node is evaluated at most once, so the sample can be classified with several operating points
+ */
+struct NodeMargins{
+	/**
+	 * starts a new sample, keeps the allocated memory
+	 */
+	void reset(std::vector<float> const &sample,uint nodeCount){
+		mSample.create(1,sample.size(),CV_32F);
+		for(uint f=0;f<sample.size();++f){
+			mSample.at<float>(0,f)=sample[f];
+		}
+		mMargins.assign(nodeCount,0.0f);
+		mEvaluated.assign(nodeCount,false);
+	}
+
+	cv::Mat mSample;
+	std::vector<float> mMargins; ///< by the index of the node
+	std::vector<bool> mEvaluated; ///< by the index of the node
+};
+
 class AdaboostClassifierNode : public AdaboostClassifier{
 public :
 	AdaboostClassifierNode(){
 		this->mPosChild.reset();
 		this->mNegChild.reset();
+		mIndex=0;
+		mNodeCount=1;
+		mModelCount=0;
+		mModelBytes=0;
+		mLoadTime=0.0;
 	}
 
     virtual void initialize(boost::shared_ptr<AdaboostClassifierNodeParams> adaboostClassifierParams);
-    std::pair<float,StageLabel> apply(std::vector<float> const &sample);
+
+    /**
+     * same as above, the models are taken from the registry. Every file is loaded once and the files are
+     * loaded concurrently, nodes with the same parameters (several parents linked to one child) are one node.
+     * Files which are registered with the same content from a previous tree are not loaded again.
+     */
+    void initialize(boost::shared_ptr<AdaboostClassifierNodeParams> adaboostClassifierParams,AdaboostModelRegistry &ioRegistry);
+    /**
+     * only reads the loaded classifiers, so one tree can be shared between several detectors and threads
+     */
+    std::pair<float,StageLabel> apply(std::vector<float> const &sample) const;
+
+    /**
+     * same as above and records the path through the tree
+     * @param ioPath bit d is set if the node at depth d decided for its positive child, has to be 0 for the root
+     * @param ioDepth number of evaluated nodes, has to be 0 for the root
+     */
+    std::pair<float,StageLabel> apply(std::vector<float> const &sample,uint32_t & ioPath,uint8_t & ioDepth) const;
+
+    /**
+     * same as above with the thresholds of an operating point, the margins of the nodes are taken from
+     * ioMargins or evaluated and stored there
+     * @param ioMargins has to be reset with getNodeCount() of the root for every sample
+     * @param operatingPoint index into AdaboostClassifierNodeParams::mOperatingPointThresholds, -1 for mThreshold
+     */
+    std::pair<float,StageLabel> apply(NodeMargins & ioMargins,int operatingPoint,uint32_t & ioPath,uint8_t & ioDepth) const;
+
+    /**
+     * @return the number of nodes of the tree below and including this node, shared nodes
+     * are only counted below their first parent
+     */
+    uint getNodeCount() const {return mNodeCount;}
+
+    /**
+     * @return the number of distinct models of the tree, only set for the root
+     */
+    uint getModelCount() const {return mModelCount;}
+
+    /**
+     * @return the estimated memory of the distinct models of the tree, only set for the root
+     */
+    std::size_t getModelBytes() const {return mModelBytes;}
+
+    /**
+     * @return [s] to load the models of the tree, only set for the root
+     */
+    double getLoadTime() const {return mLoadTime;}
+
+    /**
+     * @return the number of additional operating points of the node
+     */
+    uint getOperatingPointCount() const {return mNodeParams->mOperatingPointThresholds.size();}
+
+    /**
+     * @param operatingPoint index into AdaboostClassifierNodeParams::mOperatingPointThresholds, -1 for mThreshold
+     */
+    float getThreshold(int operatingPoint) const;
+
+    /**
+     * evaluates the model of the node and the response of every weak learner, e.g. for profiling
+     * @param oResponses 1 x number of weak learners, the response of learner i is oResponses.at<float>(0,i)
+     * @return the margin without the threshold, the sum of oResponses
+     */
+    float predictWeakResponses(cv::Mat const &sample,cv::Mat &oResponses) const;
+
+    /**
+     * @return the index of the node in depth first order, the index in NodeMargins
+     */
+    uint getIndex() const {return mIndex;}
+
+    AdaboostClassifierNodeParams const& getNodeParams() const {return *mNodeParams;}
+
+    /**
+     * @return the model of the node, shared with the other nodes of the same file
+     */
+    AdaboostModel const& getModel() const {return *mModel;}
 
     boost::shared_ptr<AdaboostClassifierNode> mPosChild;
     boost::shared_ptr<AdaboostClassifierNode> mNegChild;
 
+protected:
+    typedef std::map<AdaboostClassifierNodeParams const*,boost::shared_ptr<AdaboostClassifierNode> > NodeMap;
+
+    /**
+     * numbers the nodes in depth first order, starting with ioIndex
+     * @param ioNodes the already initialized nodes by their parameters
+     */
+    void initialize(boost::shared_ptr<AdaboostClassifierNodeParams> adaboostClassifierParams,AdaboostModelRegistry const &registry,NodeMap & ioNodes,uint & ioIndex);
+
+    boost::shared_ptr<AdaboostClassifierNode> getChild(boost::shared_ptr<AdaboostClassifierNodeParams> childParams,AdaboostModelRegistry const &registry,NodeMap & ioNodes,uint & ioIndex);
+
+    float predict(cv::Mat const &sample) const {
+        return mModel->mBoost.predict(sample,cv::Mat(),cv::Range::all(),false,true);
+    }
+
 protected:
     boost::shared_ptr<AdaboostClassifierNodeParams> mNodeParams;
+    AdaboostModelRegistry::ModelPtr mModel; ///< shared with the nodes of the same file
+    uint mIndex; ///< index of the node in NodeMargins
+    uint mNodeCount;
+    uint mModelCount;
+    std::size_t mModelBytes;
+    double mLoadTime;
 };
 
 
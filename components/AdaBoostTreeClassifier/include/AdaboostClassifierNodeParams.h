@@ -76,6 +76,7 @@ struct AdaboostClassifierNodeParams : public AdaboostClassifierParams{
     	r.member("ClassifierDescription",mClassifierDescription,"");
     	r.member("PosChild",mPosChild,"");
     	r.member("NegChild",mNegChild,"");
+    	r.member("OperatingPointThresholds",mOperatingPointThresholds,"");
     }
 
 	StageLabel mPosLabel;
@@ -83,6 +84,8 @@ struct AdaboostClassifierNodeParams : public AdaboostClassifierParams{
 	string mClassifierDescription;
 	boost::shared_ptr<AdaboostClassifierNodeParams> mPosChild;
 	boost::shared_ptr<AdaboostClassifierNodeParams> mNegChild;
+	/// thresholds of the node for additional operating points, e.g. a safety stop with a higher recall
+	std::vector<float> mOperatingPointThresholds;
 };
 
 #endif /* ADABOOSTCLASSIFERTREENODEPARAMS_H_ */
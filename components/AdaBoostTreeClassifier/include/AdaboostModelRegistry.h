@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file AdaboostModelRegistry.h
+ *    loads every opencv model of a classifier tree once
+ */
+
+#ifndef ADABOOSTMODELREGISTRY_H
+#define ADABOOSTMODELREGISTRY_H
+
+#include <opencv/cv.h>
+#include <opencv/ml.h>
+#include <boost/shared_ptr.hpp>
+#include <boost/exception_ptr.hpp>
+#include <atomic>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace mira {
+namespace adaboosttreeclassifier {
+
+/**
+ * a loaded opencv adaboost model, shared by all nodes which use the same file
+ */
+struct AdaboostModel{
+	AdaboostModel(){
+		mHash=0;
+		mFileBytes=0;
+		mBytes=0;
+	}
+
+	std::string mPath;
+	uint64_t mHash; ///< of the content of the file
+	std::size_t mFileBytes;
+	std::size_t mBytes; ///< estimated memory of the weak learners
+	/// by weak learner, the variables read by the splits of its tree (the features if the model was trained without a variable subset)
+	std::vector<std::vector<int> > mFeatures;
+	cv::Boost mBoost;
+};
+
+/**
+ * Provides the models of the nodes of classifier trees. The models are registered by their file path
+ * and the hash of the file content, a file is loaded once for all nodes referencing it and again only
+ * if its content changed. The files which are not registered yet are loaded concurrently.
+ */
+class AdaboostModelRegistry{
+public:
+	typedef boost::shared_ptr<AdaboostModel const> ModelPtr;
+
+	AdaboostModelRegistry(){
+		mLoadedModels=0;
+		mLoadTime=0.0;
+	}
+
+	/**
+	 * provides the models of the files, registered models with the same file content are reused
+	 * the models of files which are not in paths are removed from the registry, trees using them keep them
+	 * @param threads maximal number of files loaded at the same time including the calling thread, 0 for one per core
+	 */
+	void load(std::vector<std::string> const &paths,uint threads=0);
+
+	/**
+	 * @return the model of the file of the last load() or an empty pointer
+	 */
+	ModelPtr get(std::string const &path) const;
+
+	/**
+	 * @return the number of models of the last load()
+	 */
+	uint getModelCount() const {return mModels.size();}
+
+	/**
+	 * @return the number of models loaded from their files by the last load(), the others were reused
+	 */
+	uint getLoadedModels() const {return mLoadedModels;}
+
+	/**
+	 * @return the estimated memory of the models of the last load()
+	 */
+	std::size_t getBytes() const;
+
+	/**
+	 * @return [s] of the last load()
+	 */
+	double getLoadTime() const {return mLoadTime;}
+
+private:
+	struct LoadJob{
+		std::string mPath;
+		ModelPtr mModel;
+		bool mLoaded;
+		boost::exception_ptr mError;
+	};
+
+	void loadJobs(std::vector<LoadJob> &ioJobs,std::atomic<uint> &ioNext) const;
+
+private:
+	std::map<std::string,ModelPtr> mModels; ///< by their path, replaced if the hash of the content changed
+	uint mLoadedModels;
+	double mLoadTime;
+};
+
+}
+}
+
+#endif
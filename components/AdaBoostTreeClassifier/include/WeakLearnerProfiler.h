@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file WeakLearnerProfiler.h
+ *    usage of the weak learners of a classifier tree over a set of samples
+ */
+
+#ifndef WEAKLEARNERPROFILER_H
+#define WEAKLEARNERPROFILER_H
+
+#include <AdaboostClassifierNode.h>
+#include <map>
+#include <ostream>
+
+namespace mira {
+namespace adaboosttreeclassifier {
+
+/**
+ * usage of one weak learner of a node
+ */
+struct WeakLearnerUsage{
+	WeakLearnerUsage(){
+		mDecisionChanges=0;
+		mAbsResponseSum=0.0;
+		mResponseSum=0.0;
+	}
+
+	uint64_t mDecisionChanges; ///< evaluations of the node whose decision flips without this learner
+	double mAbsResponseSum;
+	double mResponseSum;
+};
+
+/**
+ * usage of the weak learners of one node of the tree
+ */
+struct NodeUsage{
+	NodeUsage(){
+		mNode=NULL;
+		mEvaluations=0;
+		mPositive=0;
+	}
+
+	AdaboostClassifierNode const *mNode;
+	uint64_t mEvaluations; ///< samples which reached the node
+	uint64_t mPositive; ///< samples passed to the positive child
+	std::vector<WeakLearnerUsage> mLearners;
+};
+
+/**
+ * Classifies samples with the default thresholds and records for every node on their path the response
+ * of every weak learner and whether the decision of the node changes without it.
+ * The same responses evaluate pruned models without writing them, see classify().
+ */
+class WeakLearnerProfiler{
+public:
+	/**
+	 * the kept weak learners of the models by their path, 1 for kept, models without an entry are complete
+	 */
+	typedef std::map<std::string,std::vector<uint8_t> > LearnerMasks;
+
+	void initialize(boost::shared_ptr<AdaboostClassifierNode const> root);
+
+	/**
+	 * classifies the sample and adds the responses of the weak learners to the usage of the nodes on its path
+	 */
+	StageLabel add(std::vector<float> const &sample);
+
+	/**
+	 * classifies the sample as if the models were pruned to the weak learners of masks
+	 * @param ioLearners the number of evaluated weak learners is added
+	 */
+	StageLabel classify(std::vector<float> const &sample,LearnerMasks const &masks,uint64_t &ioLearners);
+
+	/**
+	 * @return the usage by the index of the nodes
+	 */
+	std::vector<NodeUsage> const& getNodes() const {return mNodes;}
+
+	/**
+	 * writes the usage as CSV, one line per weak learner of every node
+	 */
+	void write(std::ostream &out) const;
+
+private:
+	void setSample(std::vector<float> const &sample);
+
+private:
+	boost::shared_ptr<AdaboostClassifierNode const> mRoot;
+	std::vector<NodeUsage> mNodes;
+	// buffers, kept to avoid allocations for every sample
+	cv::Mat mSample;
+	cv::Mat mResponses;
+};
+
+}
+}
+
+#endif
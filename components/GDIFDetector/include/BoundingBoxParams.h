@@ -52,6 +52,18 @@
 enum BoxMode{CENTER=0,LEFT=1};
 
 struct BoundingBoxParams{
+	BoundingBoxParams(){
+		mBinQuantity=15;
+		mBoxWidth=0.8f;
+		mBoxHeight=3.0f;
+		mBoxMode=CENTER;
+		mBoxFromLeftOffset=-0.3f;
+		mUseHighFreqFeats=true;
+		mFeatureResolution=0.0f;
+		mGeometryTableSize=0;
+		mGeometryTableMinRange=0.1f;
+	}
+
     template<typename Reflector>
     void reflect(Reflector& r) {
     	r.member("BinQuantity", mBinQuantity, "");
@@ -60,6 +72,9 @@ struct BoundingBoxParams{
     	r.member("BoxMode", mBoxMode, "");
     	r.member("BoxFromLeftOffset",mBoxFromLeftOffset,"");
     	r.member("UseHighFreqFeats",mUseHighFreqFeats,"");
+    	r.member("FeatureResolution",mFeatureResolution,"");
+    	r.member("GeometryTableSize",mGeometryTableSize,"");
+    	r.member("GeometryTableMinRange",mGeometryTableMinRange,"");
     }
 
     int mBinQuantity;
@@ -68,6 +83,15 @@ struct BoundingBoxParams{
     BoxMode mBoxMode;
     float mBoxFromLeftOffset;
     bool mUseHighFreqFeats;
+    /// [rad] the beams of a box are decimated to at most two beams (the nearest and the farthest) per
+    /// mFeatureResolution, but at least two per bin, so the cost of the features of near boxes does not
+    /// grow with the resolution of the sensor, 0 for all beams
+    float mFeatureResolution;
+    /// the angles of the bin end points are interpolated from a table with this many steps of the inverse
+    /// center range instead of calculated with atan2, see BoxGeometryTable, 0 for the exact calculation
+    int mGeometryTableSize;
+    /// [m] boxes nearer than this are calculated exactly
+    float mGeometryTableMinRange;
 };
 
 #endif /* BOUNDINGBOXPARAMS_H_ */
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file BoxGeometryTable.h
+ *    header File for the tabulated geometry of the bounding boxes
+ */
+
+#ifndef BOXGEOMETRYTABLE_H_
+#define BOXGEOMETRYTABLE_H_
+
+#include <vector>
+#include <BoundingBoxParams.h>
+
+namespace mira { namespace laserbasedobjectdetection {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The end point i of a bin lies t_i=i*width/binQuantity-width/2 from the center of the box, orthogonal to
+ * the beam through the center, so its angle is the angle of the center plus atan(t_i/R) for the center
+ * range R. The offsets depend only on R and are tabulated over the inverse range u=1/R in
+ * [0,1/mGeometryTableMinRange], where atan(t_i*u) is smooth up to infinitely far boxes, and linearly
+ * interpolated. With the step h of u the error is at most h^2/8*max|f''| with |f''|<=3*sqrt(3)/8*t^2,
+ * e.g. 1.2e-6 rad for a 0.8 m wide box, 1024 entries and 0.1 m minimal range, plus the rounding of the
+ * float angles of a few 1e-7 rad. This is far below the angular resolution of the sensors, only a beam
+ * within the error of a bin border may fall into the neighbouring bin. Nearer boxes are calculated exactly.
+ */
+class BoxGeometryTable{
+public:
+	BoxGeometryTable(){
+		mBinQuantity=0;
+		mEntries=0;
+		mStep=0.0f;
+		mMaxInverseRange=0.0f;
+		mMaxError=0.0f;
+	}
+
+	/**
+	 * tabulates the offsets of the boxes of the params, the table stays empty if mGeometryTableSize is 0
+	 */
+	void initialize(BoundingBoxParams const& params);
+
+	bool inline isEnabled() const {return !mOffsets.empty();}
+
+	/**
+	 * @return true if the offsets of a box with this center range are tabulated
+	 */
+	bool inline covers(float centerRange) const {return isEnabled()&&centerRange*mMaxInverseRange>=1.0f;}
+
+	/**
+	 * interpolates the angular offsets of the bin end points to the angle of the center, see covers()
+	 * @param oOffsets [rad] binQuantity offsets, from the right to the left end point
+	 */
+	void getOffsets(float centerRange,float * oOffsets) const;
+
+	/**
+	 * @return [rad] the bound of the interpolation error of the offsets, without the rounding
+	 */
+	float inline getMaxError() const {return mMaxError;}
+
+private:
+	int mBinQuantity;
+	int mEntries; ///< steps of the inverse range, the table has mEntries+1 rows
+	float mStep; ///< [1/m] of the inverse range between two rows
+	float mMaxInverseRange; ///< [1/m]
+	float mMaxError; ///< [rad]
+	std::vector<float> mOffsets; ///< [rad] mBinQuantity offsets per row
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif /* BOXGEOMETRYTABLE_H_ */
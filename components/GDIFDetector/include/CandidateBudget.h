@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file CandidateBudget.h
+ *    header File for the real-time candidate budget (priority order and limits per scan)
+ */
+
+#ifndef CANDIDATEBUDGET_H_
+#define CANDIDATEBUDGET_H_
+
+#include <vector>
+#include <stdint.h>
+#include <Segmentation.h>
+#include <CandidateBudgetParams.h>
+
+namespace mira { namespace laserbasedobjectdetection {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * bounds the work per scan for a deadline: the candidates are processed in the order of their priority
+ * until the maximum number of candidates or the time budget is used up, the rest is skipped
+ * the time is checked before every candidate, so a stage overruns its budget by at most one candidate
+ */
+class CandidateBudget{
+public:
+	CandidateBudget(){}
+
+	void initialize(CandidateBudgetParams const& params);
+
+	bool inline isEnabled() const {return mParams.mEnabled;}
+
+	/**
+	 * @return true if the number of candidates per scan is limited
+	 */
+	bool inline limitsCount() const {return mParams.mEnabled&&mParams.mMaxCandidates>0;}
+
+	/**
+	 * orders the candidates by priority, candidates further away than maxRange are left out
+	 * @param oOrder the indices of the candidates, the most important first
+	 * @param oOutOfRange the number of candidates left out
+	 */
+	void order(std::vector<SegmentCandidate> const& candidates,float maxRange,std::vector<uint> & oOrder,uint & oOutOfRange);
+
+	/**
+	 * @return the end of the time budget of a scan whose extraction starts now, see isExhausted()
+	 */
+	uint64_t getDeadline() const;
+
+	/**
+	 * @param candidates number of candidates already processed in this scan
+	 * @return true if no further candidate may be processed
+	 */
+	bool isExhausted(uint candidates,uint64_t deadline) const;
+
+private:
+	CandidateBudgetParams mParams;
+
+	// buffer, kept to avoid allocations for every scan
+	std::vector<std::pair<float,uint> > mPriorities;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif /* CANDIDATEBUDGET_H_ */
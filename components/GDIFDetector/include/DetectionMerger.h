@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file DetectionMerger.h
+ *    header File for the merging of nearby detections (e.g. both legs of a person)
+ */
+
+#ifndef DETECTIONMERGER_H_
+#define DETECTIONMERGER_H_
+
+#include <vector>
+#include <GDIFDetection.h>
+#include <DetectionMergerParams.h>
+
+namespace mira { namespace laserbasedobjectdetection {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * merges detections of the same label which are closer than the merge radius of the label to a more
+ * confident detection: the detections absorb their neighbours in the order of their absolute margins
+ * (a greedy non-maximum suppression), so a merged detection spans at most twice the radius and a row of
+ * people closer than the radius is not chained into one detection
+ * the detections are sorted by the cells of a grid of the largest merge radius,
+ * so only the 3x3 neighbouring cells have to be searched and the merging takes O(n log n)
+ * for a bounded density of detections
+ */
+class DetectionMerger{
+public:
+	DetectionMerger(){}
+
+	void initialize(DetectionMergerParams const& params);
+
+	bool inline isEnabled() const {return mParams.mEnabled;}
+
+	/**
+	 * merges the detections in place, the position of a merged detection is the average of its members
+	 * weighted by their absolute margins, label, margin and tree path are the ones of the most confident
+	 * member, which absorbed the others
+	 * the merged detections keep the order of their most confident member
+	 * @return number of removed detections
+	 */
+	uint merge(std::vector<GDIFDetection> & ioDetections);
+
+private:
+	DetectionMergerParams mParams;
+	float mCellSize;
+
+	// buffers, kept to avoid allocations for every scan
+	std::vector<std::pair<uint64_t,uint> > mCells; ///< cell key and index, sorted
+	std::vector<std::pair<float,uint> > mOrder; ///< negative absolute margin and index
+	std::vector<uint> mOwner; ///< the detection which absorbed a detection, itself for the remaining ones
+	std::vector<float> mWeightSum;
+	std::vector<Point2f> mWeightedPosition;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif /* DETECTIONMERGER_H_ */
@@ -0,0 +1,75 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file GDIFDetection.h
+ *    header File for a single detection of the GDIF detector
+ */
+
+#ifndef GDIFDETECTION_H_
+#define GDIFDETECTION_H_
+
+#include <geometry/Point.h>
+#include <boost/shared_ptr.hpp>
+#include <AdaboostClassifierParams.h>
+#include <AdaboostClassifierNodeParams.h>
+
+struct GDIFDetection{
+	GDIFDetection(){}
+	GDIFDetection(mira::Point2f const& position,StageLabel label,float margin,uint32_t path=0,uint8_t depth=0) :
+		mPosition(position), mLabel(label), mMargin(margin), mPath(path), mDepth(depth){}
+
+    template<typename Reflector>
+    void reflect(Reflector& r) {
+    	r.member("Position", mPosition, "");
+    	r.member("Label", mLabel, "");
+    	r.member("Margin", mMargin, "");
+    	r.member("Path", mPath, "");
+    	r.member("Depth", mDepth, "");
+    }
+
+	mira::Point2f mPosition; ///< position in the frame of the sensor
+	StageLabel mLabel; ///< the label of the leaf of the classifier tree
+	float mMargin; ///< the margin of the last classifier of the tree, including its threshold
+	uint32_t mPath; ///< bit d is set if the classifier at depth d of the tree decided positive
+	uint8_t mDepth; ///< number of classifiers evaluated for the detection
+};
+
+#endif /* GDIFDETECTION_H_ */
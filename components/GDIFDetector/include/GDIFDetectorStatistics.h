@@ -0,0 +1,243 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file GDIFDetectorStatistics.h
+ *    header File for the statistics of a single classified scan
+ */
+
+#ifndef GDIFDETECTORSTATISTICS_H_
+#define GDIFDETECTORSTATISTICS_H_
+
+#include <sys/types.h>
+#include <stdint.h>
+#include <vector>
+
+#ifdef GANDALF_STAGE_TIMING
+#include <chrono>
+#endif
+
+namespace mira { namespace laserbasedobjectdetection {
+
+///////////////////////////////////////////////////////////////////////////////
+
+#ifdef GANDALF_STAGE_TIMING
+/**
+ * @return a steady timestamp in [ns] for the timing of the stages
+ */
+inline uint64_t getStageTimestamp(){
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// declares the timestamp variable start
+#define GANDALF_STAGE_START(start) uint64_t start = ::mira::laserbasedobjectdetection::getStageTimestamp()
+/// adds the time since the timestamp start to duration
+#define GANDALF_STAGE_STOP(start, duration) duration += ::mira::laserbasedobjectdetection::getStageTimestamp() - start
+#else
+// without GANDALF_STAGE_TIMING the stages are not timed at all, the durations stay 0
+#define GANDALF_STAGE_START(start)
+#define GANDALF_STAGE_STOP(start, duration)
+#endif
+
+struct GDIFDetectorStatistics{
+	GDIFDetectorStatistics(){
+		reset();
+	}
+
+	void reset(){
+		mSegments=0;
+		mSmallSegments=0;
+		mCandidates=0;
+		mInvalidBeamSegments=0;
+		mOutOfRange=0;
+		mPreFilterInput=0;
+		mPreFilterRejected=0;
+		mBackgroundRejected=0;
+		mMergedDetections=0;
+		mSkippedCandidates=0;
+		mOutsideRegionsOfInterest=0;
+		mInvalidBoxes=0;
+		mClassified=0;
+		mNodeEvaluations.clear();
+		mLabels.clear();
+		mSegmentationTime=0;
+		mFeatureTime=0;
+		mClassificationTime=0;
+	}
+
+	/**
+	 * @return the fraction of the candidates reaching the pre-filter which were rejected by it
+	 */
+	float getPreFilterRejectionRatio() const{
+		return mPreFilterInput>0 ? (float)mPreFilterRejected/(float)mPreFilterInput : 0.0f;
+	}
+
+    template<typename Reflector>
+    void reflect(Reflector& r) {
+    	r.member("Segments", mSegments, "");
+    	r.member("SmallSegments", mSmallSegments, "");
+    	r.member("Candidates", mCandidates, "");
+    	r.member("InvalidBeamSegments", mInvalidBeamSegments, "");
+    	r.member("OutOfRange", mOutOfRange, "");
+    	r.member("PreFilterInput", mPreFilterInput, "");
+    	r.member("PreFilterRejected", mPreFilterRejected, "");
+    	r.member("BackgroundRejected", mBackgroundRejected, "");
+    	r.member("MergedDetections", mMergedDetections, "");
+    	r.member("SkippedCandidates", mSkippedCandidates, "");
+    	r.member("OutsideRegionsOfInterest", mOutsideRegionsOfInterest, "");
+    	r.member("InvalidBoxes", mInvalidBoxes, "");
+    	r.member("Classified", mClassified, "");
+    	r.member("NodeEvaluations", mNodeEvaluations, "");
+    	r.member("Labels", mLabels, "");
+    	r.member("SegmentationTime", mSegmentationTime, "");
+    	r.member("FeatureTime", mFeatureTime, "");
+    	r.member("ClassificationTime", mClassificationTime, "");
+    }
+
+	uint mSegments; ///< segments between the break points of the scan
+	uint mSmallSegments; ///< segments removed because they have less than SegmentationParams::mMinSegmentSize beams
+	uint mCandidates; ///< segment centers handed to the classification
+	uint mInvalidBeamSegments; ///< segments removed because they consist of invalid beams
+	uint mOutOfRange; ///< candidates farther than SegmentationParams::mMaxRange
+	uint mPreFilterInput; ///< candidates checked by the geometric pre-filter
+	uint mPreFilterRejected; ///< candidates rejected by the geometric pre-filter
+	uint mBackgroundRejected; ///< candidates skipped because they lie on the learned background
+	uint mMergedDetections; ///< detections removed by merging them into a nearby detection
+	uint mSkippedCandidates; ///< candidates not classified because the candidate budget was used up
+	uint mOutsideRegionsOfInterest; ///< candidates skipped because they are outside of the regions of interest
+	uint mInvalidBoxes; ///< candidates whose bounding box is not valid
+	uint mClassified; ///< candidates classified by the tree
+	std::vector<uint> mNodeEvaluations; ///< by AdaboostClassifierNode::getIndex(), including the operating points
+	std::vector<uint> mLabels; ///< classified candidates by their label+1 (NO_PERSON at 0), before merging
+	// only measured with GANDALF_STAGE_TIMING
+	uint64_t mSegmentationTime; ///< [ns] segmentation and the angles of the beams
+	uint64_t mFeatureTime; ///< [ns] background model, pre-filter, bounding boxes and features
+	uint64_t mClassificationTime; ///< [ns] classification and merging
+};
+
+/**
+ * sums of the statistics of several scans, e.g. for the diagnostics of a period
+ */
+struct GDIFDetectorTotals{
+	GDIFDetectorTotals(){
+		reset();
+	}
+
+	void reset(){
+		mScans=0;
+		mSegments=0;
+		mSmallSegments=0;
+		mInvalidBeamSegments=0;
+		mCandidates=0;
+		mOutOfRange=0;
+		mOutsideRegionsOfInterest=0;
+		mBackgroundRejected=0;
+		mPreFilterRejected=0;
+		mInvalidBoxes=0;
+		mSkippedCandidates=0;
+		mClassified=0;
+		mNodeEvaluations.clear();
+		mLabels.clear();
+	}
+
+	void add(GDIFDetectorStatistics const& statistics){
+		mScans++;
+		mSegments+=statistics.mSegments;
+		mSmallSegments+=statistics.mSmallSegments;
+		mInvalidBeamSegments+=statistics.mInvalidBeamSegments;
+		mCandidates+=statistics.mCandidates;
+		mOutOfRange+=statistics.mOutOfRange;
+		mOutsideRegionsOfInterest+=statistics.mOutsideRegionsOfInterest;
+		mBackgroundRejected+=statistics.mBackgroundRejected;
+		mPreFilterRejected+=statistics.mPreFilterRejected;
+		mInvalidBoxes+=statistics.mInvalidBoxes;
+		mSkippedCandidates+=statistics.mSkippedCandidates;
+		mClassified+=statistics.mClassified;
+		addCounts(statistics.mNodeEvaluations,mNodeEvaluations);
+		addCounts(statistics.mLabels,mLabels);
+	}
+
+	void add(GDIFDetectorTotals const& totals){
+		mScans+=totals.mScans;
+		mSegments+=totals.mSegments;
+		mSmallSegments+=totals.mSmallSegments;
+		mInvalidBeamSegments+=totals.mInvalidBeamSegments;
+		mCandidates+=totals.mCandidates;
+		mOutOfRange+=totals.mOutOfRange;
+		mOutsideRegionsOfInterest+=totals.mOutsideRegionsOfInterest;
+		mBackgroundRejected+=totals.mBackgroundRejected;
+		mPreFilterRejected+=totals.mPreFilterRejected;
+		mInvalidBoxes+=totals.mInvalidBoxes;
+		mSkippedCandidates+=totals.mSkippedCandidates;
+		mClassified+=totals.mClassified;
+		addCounts(totals.mNodeEvaluations,mNodeEvaluations);
+		addCounts(totals.mLabels,mLabels);
+	}
+
+	uint64_t mScans;
+	uint64_t mSegments;
+	uint64_t mSmallSegments;
+	uint64_t mInvalidBeamSegments;
+	uint64_t mCandidates;
+	uint64_t mOutOfRange;
+	uint64_t mOutsideRegionsOfInterest;
+	uint64_t mBackgroundRejected;
+	uint64_t mPreFilterRejected;
+	uint64_t mInvalidBoxes;
+	uint64_t mSkippedCandidates;
+	uint64_t mClassified;
+	std::vector<uint64_t> mNodeEvaluations; ///< see GDIFDetectorStatistics::mNodeEvaluations
+	std::vector<uint64_t> mLabels; ///< see GDIFDetectorStatistics::mLabels
+
+private:
+	template<typename T>
+	static void addCounts(std::vector<T> const& counts,std::vector<uint64_t> & ioTotals){
+		if(ioTotals.size()<counts.size())ioTotals.resize(counts.size(),0);
+		for(uint i=0;i<counts.size();i++){
+			ioTotals[i]+=counts[i];
+		}
+	}
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif /* GDIFDETECTORSTATISTICS_H_ */
@@ -46,11 +46,23 @@
  * @date   2014/08/22
  */
 
+#ifndef GDIFDETECTORTREE_H_
+#define GDIFDETECTORTREE_H_
+
 #include <AdaboostClassifierNode.h>
 #include <BoundingBoxParams.h>
 #include <Segmentation.h>
 #include <SegmentationParams.h>
+#include <SegmentPreFilter.h>
+#include <OnlineBackgroundModel.h>
 #include <GDIFeatures.h>
+#include <GDIFDetectorStatistics.h>
+#include <GDIFDetection.h>
+#include <DetectionMerger.h>
+#include <CandidateBudget.h>
+#include <RegionOfInterestFilter.h>
+#include <ParallelParams.h>
+#include <WorkStealingPool.h>
 
 using namespace mira;
 using namespace mira::robot;
@@ -60,15 +72,63 @@ namespace mira { namespace laserbasedobjectdetection {
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * the candidates of a scan and their features, the result of GDIFDetectorTree::extractCandidates()
+ */
+struct GDIFCandidates{
+	GDIFCandidates():mDeadline(0){}
+
+	void clear(){
+		mPositions.clear();
+		mFeatures.clear();
+		mStatistics.reset();
+		mDeadline=0;
+	}
+
+	std::vector<Point2f> mPositions; ///< the reference points of the boxes
+	std::vector<std::vector<float> > mFeatures; ///< the features of the boxes
+	GDIFDetectorStatistics mStatistics; ///< statistics of the extraction
+	uint64_t mDeadline; ///< of the candidate budget, taken at the start of the extraction and shared by the classification, 0 for none
+};
+
 class GDIFDetectorTree {
 private:
     string mClassifierPath;
     boost::shared_ptr<AdaboostClassifierNodeParams> mAdaboostParams;
     BoundingBoxParams mBoundingBoxParams;
     SegmentationParams mSegmentationParams;
-    AdaboostClassifierNode mClassifier;
+    SegmentPreFilter mPreFilter;
+    OnlineBackgroundModel mBackgroundModel;
+    DetectionMerger mDetectionMerger;
+    CandidateBudget mCandidateBudget;
+    RegionOfInterestFilter mRegionsOfInterest;
+    BoxGeometryTable mBoxGeometryTable;
+    boost::shared_ptr<AdaboostClassifierNode const> mClassifier;
     std::vector<float> mAngles;
+    float mAnglesStart; ///< start angle of the scan geometry mAngles was calculated for
+    float mAnglesDelta; ///< angle increment of the scan geometry mAngles was calculated for
     bool firstScan;
+    GDIFDetectorStatistics mStatistics;
+    // buffers, kept to avoid allocations for every scan
+    std::vector<SegmentCandidate> mSegmentCandidates; ///< only used by extractCandidates()
+    std::vector<uint> mBreakPoints; ///< only used by extractCandidates()
+    std::vector<uint> mCandidateOrder; ///< only used by extractCandidates()
+    std::vector<GDIFDetection> mDetections; ///< only used by classifyCandidates()
+    std::vector<std::vector<GDIFDetection> > mOperatingPointDetections; ///< only used by classifyCandidates()
+    NodeMargins mNodeMargins; ///< only used by classifyCandidates()
+    // parallel processing of the candidates, one pool per stage, so both stages can run concurrently
+    ParallelParams mParallelParams;
+    boost::shared_ptr<WorkStealingPool> mExtractionPool;
+    boost::shared_ptr<WorkStealingPool> mClassificationPool;
+    float mExtractionCost; ///< [ns] per candidate, moving average
+    float mClassificationCost; ///< [ns] per candidate, moving average
+    // results of the parallel processing by candidate, merged in order afterwards
+    std::vector<uint8_t> mSlotOutcomes; ///< CandidateOutcome, only used by extractCandidates()
+    std::vector<std::vector<float> > mSlotFeatures; ///< exchanged with the previous features of the candidates, only used by extractCandidates()
+    std::vector<uint8_t> mSlotClassified; ///< only used by classifyCandidates()
+    std::vector<GDIFDetection> mSlotDetections; ///< default and operating points, only used by classifyCandidates()
+    std::vector<NodeMargins> mWorkerMargins; ///< by worker, only used by classifyCandidates()
+    std::vector<std::vector<uint> > mWorkerNodeEvaluations; ///< by worker, only used by classifyCandidates()
     //std::vector<RangeSegment> mRangeSegments;
 
 public:
@@ -77,9 +137,188 @@ public:
     		 	 	 SegmentationParams segmentationParams,
     		 	 	 BoundingBoxParams boundingBoxParams);
 
-    std::vector<StageLabel> classifyScan(RangeScan const& iRangeScan,std::vector<Point2f> & oPositions);
+    /**
+     * initializes the detector with an already loaded classifier tree, e.g. to share one model
+     * between the detectors of several sensors
+     */
+    void inititalize(boost::shared_ptr<AdaboostClassifierNode const> classifier,
+    		 	 	 SegmentationParams segmentationParams,
+    		 	 	 BoundingBoxParams boundingBoxParams);
+
+    /**
+     * @return the loaded classifier tree, it can be passed to other detectors
+     */
+    boost::shared_ptr<AdaboostClassifierNode const> getClassifier() const {return boost::atomic_load(&mClassifier);}
+
+    /**
+     * replaces the classifier tree, may be called from another thread while a scan is processed.
+     * A scan uses the tree which was set when its classification started, the old tree is released
+     * when the last scan using it is finished.
+     */
+    void setClassifier(boost::shared_ptr<AdaboostClassifierNode const> classifier){boost::atomic_store(&mClassifier,classifier);}
+
+    /**
+     * enables the geometric pre-filter between the segmentation and the feature extraction
+     */
+    void setPreFilterParams(SegmentPreFilterParams const& preFilterParams);
+
+    /**
+     * enables the online background model for stationary sensors, candidates on the background are not classified
+     * uses SegmentationParams::mBackgroundJumpDistance to separate foreground from background
+     */
+    void setBackgroundModelParams(BackgroundModelParams const& backgroundModelParams);
+
+    OnlineBackgroundModel const& getBackgroundModel() const {return mBackgroundModel;}
+
+    /**
+     * enables the merging of nearby detections of the same label after the classification
+     */
+    void setDetectionMergerParams(DetectionMergerParams const& detectionMergerParams);
+
+    /**
+     * enables the real-time mode: the candidates are processed by priority until the budget is used up,
+     * the skipped candidates are counted in GDIFDetectorStatistics::mSkippedCandidates
+     */
+    void setCandidateBudgetParams(CandidateBudgetParams const& candidateBudgetParams);
+
+    /**
+     * enables the region of interest mode: only candidates inside the regions are processed, except for
+     * every RegionOfInterestParams::mFullScanInterval-th scan
+     */
+    void setRegionOfInterestParams(RegionOfInterestParams const& regionOfInterestParams);
+
+    /**
+     * sets the regions of interest for the following scans, e.g. the predicted positions of the tracks,
+     * an empty list restricts the detector to the full scans
+     */
+    void setRegionsOfInterest(std::vector<RegionOfInterest> const& regions);
+
+    /**
+     * every scan is processed completely until setRegionsOfInterest() is called again
+     */
+    void clearRegionsOfInterest();
+
+    /**
+     * enables the parallel processing of the candidates of a scan with ParallelParams::mThreads threads per stage,
+     * the detections and statistics are the same as with the serial processing
+     * (except for candidates skipped by the time budget)
+     */
+    void setParallelParams(ParallelParams const& parallelParams);
+
+    std::vector<StageLabel> classifyScan(RangeScanView const& iRangeScan,std::vector<Point2f> & oPositions);
+
+    /**
+     * classifies all candidates of the scan, same as extractCandidates() followed by classifyCandidates()
+     * the scan is only read, a RangeScan or any other buffer can be passed as RangeScanView
+     * @param oDetections the detections (everything not classified as NO_PERSON) are appended
+     */
+    void classifyScan(RangeScanView const& iRangeScan,std::vector<GDIFDetection> & oDetections);
+
+    /**
+     * first stage of the detection: segmentation, filtering of the candidates, bounding boxes and features
+     * for a pipelined processing it may run concurrently to classifyCandidates() of the previous scan
+     */
+    void extractCandidates(RangeScanView const& iRangeScan,GDIFCandidates & oCandidates);
+
+    /**
+     * second stage of the detection: classification and merging of the detections
+     * @param oDetections the detections (everything not classified as NO_PERSON) are appended
+     */
+    void classifyCandidates(GDIFCandidates const& iCandidates,std::vector<GDIFDetection> & oDetections);
+
+    /**
+     * same as above, additionally the candidates are labeled with the thresholds of every operating point
+     * of the classifier tree. The margins of the nodes are shared, so a node is evaluated at most once per
+     * candidate and only nodes which are not on the path of the default thresholds cost additional time.
+     * @param oOperatingPointDetections resized to getOperatingPointCount(), the detections of operating
+     *        point k are appended to element k
+     */
+    void classifyCandidates(GDIFCandidates const& iCandidates,std::vector<GDIFDetection> & oDetections,
+                            std::vector<std::vector<GDIFDetection> > & oOperatingPointDetections);
+
+    /**
+     * @return the number of additional operating points of the classifier tree,
+     *         see AdaboostClassifierNodeParams::mOperatingPointThresholds
+     */
+    uint getOperatingPointCount() const {
+    	boost::shared_ptr<AdaboostClassifierNode const> classifier = getClassifier();
+    	return classifier ? classifier->getOperatingPointCount() : 0;
+    }
+
+    /**
+     * @return the statistics of the last classified scan (written by classifyCandidates()): the funnel from
+     * the segments to the classified candidates, the evaluations of every node of the tree and the labels
+     */
+    GDIFDetectorStatistics const& getStatistics() const {return mStatistics;}
+
+private:
+    enum CandidateOutcome{
+    	CANDIDATE_OUT_OF_RANGE=0,
+    	CANDIDATE_OUTSIDE_REGIONS,
+    	CANDIDATE_BACKGROUND,
+    	CANDIDATE_PRE_FILTERED,
+    	CANDIDATE_INVALID_BOX,
+    	CANDIDATE_VALID,
+    	CANDIDATE_SKIPPED
+    };
+
+    /**
+     * filters a candidate and calculates its features, only reads the detector
+     */
+    CandidateOutcome extractCandidate(RangeScanView const& iRangeScan,SegmentCandidate const& candidate,std::vector<float> & oFeatures) const;
+
+    /**
+     * adds the outcome of a candidate to the statistics
+     * @return true if the candidate has features
+     */
+    bool countOutcome(CandidateOutcome outcome,GDIFDetectorStatistics & ioStatistics) const;
+
+    /**
+     * classifies a candidate with the default thresholds (oDetections[0]) and all operating points
+     */
+    void classifyCandidate(AdaboostClassifierNode const& classifier,std::vector<float> const& features,Point2f const& position,
+                           uint operatingPoints,NodeMargins & ioMargins,GDIFDetection * oDetections) const;
+
+    /**
+     * adds the nodes evaluated for a candidate by classifyCandidate() to the counts by node
+     */
+    static void countNodeEvaluations(NodeMargins const& margins,std::vector<uint> & ioNodeEvaluations);
+
+    /**
+     * counts a classified candidate and its default label
+     */
+    static void countLabel(StageLabel label,GDIFDetectorStatistics & ioStatistics);
+
+    /**
+     * adds the results of classifyCandidate() which are not NO_PERSON to the detections
+     */
+    void addDetections(GDIFDetection const* detections,uint operatingPoints);
+
+    /// worker function of the extraction pool for the candidates [begin,end) of mCandidateOrder
+    void extractRange(RangeScanView const& iRangeScan,uint64_t deadline,uint begin,uint end);
+
+    /// worker function of the classification pool for the candidates [begin,end)
+    void classifyRange(AdaboostClassifierNode const& classifier,GDIFCandidates const& iCandidates,uint64_t deadline,
+                       uint operatingPoints,uint begin,uint end,uint worker);
+
+    /**
+     * @return 1 for the serial processing
+     */
+    uint getWorkerCount(boost::shared_ptr<WorkStealingPool> const& pool,uint candidates) const;
+
+    /**
+     * @param cost [ns] per candidate
+     */
+    uint getChunkSize(float cost,uint candidates,uint workers) const;
+
+    static void updateCandidateCost(float & ioCost,uint64_t duration,uint candidates);
+
+    void classify(GDIFCandidates const& iCandidates,std::vector<GDIFDetection> & oDetections,
+                  std::vector<std::vector<GDIFDetection> > * oOperatingPointDetections);
 };
 
 ///////////////////////////////////////////////////////////////////////////////
 
 }}
+
+#endif /* GDIFDETECTORTREE_H_ */
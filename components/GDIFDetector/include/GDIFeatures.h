@@ -51,7 +51,9 @@
 
 #include <limits>
 #include <BoundingBoxParams.h>
+#include <BoxGeometryTable.h>
 #include <robot/RangeScan.h>
+#include <RangeScanView.h>
 #include <geometry/Point.h>
 
 
@@ -65,7 +67,7 @@ const float NaNf =std::numeric_limits<float>::signaling_NaN();
 
 class GDIFeatures{
 public :
-	GDIFeatures(){}
+	GDIFeatures(){mDecimation=1;}
     ~GDIFeatures(){}
 
     /** builds the bounding box by using the center of the segment  as the reference point for the center of the box
@@ -75,10 +77,12 @@ public :
      *  @param the height of the box
      *  @param the binquantity of the box of the box
      *  @param useMoreFeatures experimental!!! - if true the features of the box will also contain the old features of the segment
+     *  @param table the angles of the bins are interpolated from the table if it covers the range of the box, NULL for the exact angles
      */
-    void buildBoxFromCenter(RangeScan const& rangescan,
+    void buildBoxFromCenter(RangeScanView const& rangescan,
                   Point2f const& center,
-                  BoundingBoxParams const& config);
+                  BoundingBoxParams const& config,
+                  BoxGeometryTable const* table=NULL);
 
     /** builds the bounding box by using the endpoint of the segment as the reference point for the left of the box
      *  @param points of the Laserscan
@@ -87,16 +91,33 @@ public :
      *  @param the height of the box
      *  @param the binquantity of the box of the box
      *  @param experimental - doesnt work right no
+     *  @param table the angles of the bins are interpolated from the table if it covers the range of the box, NULL for the exact angles
      */
-    void buildBoxFromLeft(RangeScan const& rangescan,
+    void buildBoxFromLeft(RangeScanView const& rangescan,
     			  Point2f const& left,
-    			  BoundingBoxParams const& config);
+    			  BoundingBoxParams const& config,
+    			  BoxGeometryTable const* table=NULL);
 
     /**  calculate the features of the box
      * @param the points of the laserscan
      */
     void calcRadialFeatures(std::vector<float> const& range,std::vector<float> const& angles);
 
+    /**  calculate the features of the box and respect the range codes of the beams
+     *   beams above the maximum range are treated as lying behind the box,
+     *   all other invalid beams are skipped
+     * @param the points of the laserscan
+     * @param the angles of the points
+     * @param the range codes of the points (RangeScan::RangeCode), empty if all points are valid
+     */
+    void calcRadialFeatures(std::vector<float> const& range,std::vector<float> const& angles,std::vector<uint16> const& valid);
+
+    /**  calculate the features of the box directly on the beams of the scan, respecting their range codes
+     * @param the scan
+     * @param the angles of the beams, see RangeScanView::getAngle()
+     */
+    void calcRadialFeatures(RangeScanView const& rangescan,std::vector<float> const& angles);
+
     /** checks that the bounding box is inside a valid angle of the rangescan
      *  @return true if the box is valid, false else
      */
@@ -159,7 +180,7 @@ public :
     /**  will return the radial features of the box
      * @return the features of the box
      */
-    std::vector<float> inline getRadialFeatures() const {
+    std::vector<float> const& getRadialFeatures() const {
 		return mRadialFeatures;
     }
 
@@ -182,6 +203,12 @@ public :
     }
 
 private :
+    /**
+     * calculates the end points of the bins and their angles around mCenter, the beam indices of the box
+     * and initializes the feature vector
+     */
+    void buildBins(RangeScanView const& rangescan,BoundingBoxParams const& config,BoxGeometryTable const* table);
+
     /**
      * @brief distance function with trigonometrie and Cross-multiplication (use this one!!!!!)
      * @param center centerpoint of the box
@@ -190,6 +217,22 @@ private :
      */
     float inline diffRange(float const& range,float const& angle);
 
+    /**
+     * adds the beam i to the features of its bin
+     * @param ioBinIndex the bin of the previous beam, the beams have to be added in increasing order
+     */
+    void inline addBeam(RangeScanView const& rays,std::vector<float> const& angles,int i,int & ioBinIndex,int * ioPointsInsideBin);
+
+    /**
+     * @return the number of beams of the scan combined by the decimation (at least 1)
+     */
+    static int getDecimation(RangeScanView const& rangescan,BoundingBoxParams const& config);
+
+    /**
+     * reduces the decimation of the box so no bin loses all of its beams
+     */
+    void limitDecimation();
+
     Point2f mCenter; // centerpoint of the Box
     float mCenterRange;
     float mCenterPhi;
@@ -207,6 +250,7 @@ private :
     int mStartIndex,mEndIndex; // the starting and ending index of the scanpoints which fall in a bin
     float mSensorResolution; //the resolutions of the sensor in radians
     bool mUseHighFreqFeats;
+    int mDecimation; // number of beams combined to their nearest and farthest beam, 1 for all beams
 
     std::vector<float > mRadialFeatures; // the features of the segment for the radial projection
 };
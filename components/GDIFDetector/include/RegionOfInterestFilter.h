@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file RegionOfInterestFilter.h
+ *    header File for the regions of interest, e.g. predicted by a tracker
+ */
+
+#ifndef REGIONOFINTERESTFILTER_H_
+#define REGIONOFINTERESTFILTER_H_
+
+#include <vector>
+#include <geometry/Point.h>
+#include <RegionOfInterestParams.h>
+
+namespace mira { namespace laserbasedobjectdetection {
+
+///////////////////////////////////////////////////////////////////////////////
+
+enum RegionOfInterestType{ROI_SECTOR=0,ROI_CIRCLE=1};
+
+/**
+ * an angular sector of the scan or a circle, in the frame of the sensor
+ */
+struct RegionOfInterest{
+	RegionOfInterest(){
+		mType=ROI_CIRCLE;
+		mMinAngle=0.0f;
+		mMaxAngle=0.0f;
+		mRadius=0.0f;
+	}
+
+	static RegionOfInterest sector(float minAngle,float maxAngle){
+		RegionOfInterest roi;
+		roi.mType=ROI_SECTOR;
+		roi.mMinAngle=minAngle;
+		roi.mMaxAngle=maxAngle;
+		return roi;
+	}
+
+	static RegionOfInterest circle(Point2f const& center,float radius){
+		RegionOfInterest roi;
+		roi.mType=ROI_CIRCLE;
+		roi.mCenter=center;
+		roi.mRadius=radius;
+		return roi;
+	}
+
+	RegionOfInterestType mType;
+	float mMinAngle; ///< [rad] sector from mMinAngle counterclockwise to mMaxAngle, the whole scan if mMaxAngle-mMinAngle>=2pi
+	float mMaxAngle; ///< [rad]
+	Point2f mCenter; ///< [m] of the circle
+	float mRadius; ///< [m] of the circle
+};
+
+/**
+ * Restricts the processing to the candidates inside the regions, e.g. around the positions predicted by a
+ * tracker. Every mFullScanInterval-th scan and every scan without regions set are processed completely,
+ * so new objects are still found.
+ */
+class RegionOfInterestFilter{
+public:
+	RegionOfInterestFilter(){
+		mHasRegions=false;
+		mScansSinceFullScan=0;
+		mFullScan=true;
+	}
+
+	void initialize(RegionOfInterestParams const& params);
+
+	bool inline isEnabled() const {return mParams.mEnabled;}
+
+	/**
+	 * replaces the regions, an empty list restricts the detector to the full scans
+	 */
+	void setRegions(std::vector<RegionOfInterest> const& regions);
+
+	/**
+	 * removes the regions, e.g. if the tracker stopped sending them, every scan is processed completely
+	 */
+	void clearRegions();
+
+	/**
+	 * decides whether the next scan is processed completely, has to be called once per scan
+	 */
+	void nextScan();
+
+	/**
+	 * @return true if the current scan is processed completely
+	 */
+	bool inline isFullScan() const {return mFullScan;}
+
+	/**
+	 * @return true if the candidate has to be processed in the current scan
+	 */
+	bool contains(Point2f const& center) const;
+
+private:
+	RegionOfInterestParams mParams;
+	std::vector<RegionOfInterest> mRegions;
+	bool mHasRegions;
+	uint mScansSinceFullScan;
+	bool mFullScan;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif /* REGIONOFINTERESTFILTER_H_ */
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file WorkStealingPool.h
+ *    header File for a thread pool which processes ranges of items with work stealing
+ */
+
+#ifndef WORKSTEALINGPOOL_H_
+#define WORKSTEALINGPOOL_H_
+
+#include <vector>
+#include <sys/types.h>
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+#include <boost/thread.hpp>
+
+namespace mira { namespace laserbasedobjectdetection {
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Processes the items [0,count) with several threads. Every worker starts with an equal share of the
+ * items and takes chunks from the front of it. A worker without items steals the back half of the
+ * largest remaining share of another worker, so expensive items do not leave the other workers idle.
+ * The calling thread is worker 0, run() returns when all items are processed.
+ * Only one run() may be active at a time.
+ */
+class WorkStealingPool{
+public:
+	/**
+	 * function(begin,end,worker) processes the items [begin,end)
+	 */
+	typedef boost::function<void (uint,uint,uint)> RangeFunction;
+
+	/**
+	 * @param workers number of workers including the calling thread, workers-1 threads are started
+	 */
+	WorkStealingPool(uint workers);
+
+	~WorkStealingPool();
+
+	uint inline getWorkerCount() const {return mShares.size();}
+
+	/**
+	 * @param chunkSize number of items a worker takes at once from its share
+	 */
+	void run(uint count,uint chunkSize,RangeFunction const& function);
+
+private:
+	void threadLoop(uint worker);
+
+	void work(uint worker);
+
+	/**
+	 * takes the next chunk of the share of the worker, steals from the other workers if it is empty
+	 */
+	bool takeChunk(uint worker,uint & oBegin,uint & oEnd);
+
+private:
+	struct Share{
+		boost::mutex mMutex;
+		uint mBegin;
+		uint mEnd;
+	};
+	std::vector<boost::shared_ptr<Share> > mShares;
+
+	RangeFunction mFunction;
+	uint mChunkSize;
+
+	boost::mutex mMutex;
+	boost::condition_variable mStartCondition;
+	boost::condition_variable mDoneCondition;
+	uint mGeneration; ///< incremented by every run()
+	uint mActiveWorkers; ///< threads which did not finish the current run
+	bool mStop;
+	boost::thread_group mThreads;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}}
+
+#endif /* WORKSTEALINGPOOL_H_ */
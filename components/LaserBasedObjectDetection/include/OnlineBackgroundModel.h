@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file OnlineBackgroundModel.h
+ *    header File for the online background model of a stationary sensor
+ */
+
+#ifndef ONLINEBACKGROUNDMODEL_H_
+#define ONLINEBACKGROUNDMODEL_H_
+
+#include <RangeScanWithBackgroundModel.h>
+#include <RangeScanView.h>
+#include <BackgroundModelParams.h>
+
+namespace mira{
+namespace laserbasedobjectdetection{
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * learns the per beam background range of a stationary sensor from the incoming scans
+ * the background of a beam is the maximum or the median of its valid ranges over a window of scans
+ * a beam is foreground if its range is smaller than background-BGJumpDistance (like in getFGClassifikation())
+ */
+class OnlineBackgroundModel{
+public:
+	OnlineBackgroundModel();
+
+	void initialize(BackgroundModelParams const& params);
+
+	bool inline isEnabled() const {return mParams.mEnabled;}
+
+	/**
+	 * @return true if enough scans were seen to use the model
+	 */
+	bool inline isReady() const {return mHistoryCount>=mParams.mMinScans&&mHistoryCount>0;}
+
+	/**
+	 * feeds a scan into the model, if the geometry of the scan changes the model is reset
+	 */
+	void update(RangeScanView const& rangeScan);
+
+	/**
+	 * removes all learned scans
+	 */
+	void reset();
+
+	/**
+	 * @return the per beam background ranges, NaN if a beam had no valid range in the window
+	 */
+	std::vector<float> const& getBackground() const {return mBackground;}
+
+	/**
+	 * @return the fraction of the beams [begin,end) which are in front of the background
+	 */
+	float getForegroundRatio(RangeScanView const& rangeScan,uint begin,uint end,float BGJumpDistance) const;
+
+	/**
+	 * @return true if the segment has less foreground beams than required and can be skipped
+	 */
+	bool inline isBackground(RangeScanView const& rangeScan,uint begin,uint end,float BGJumpDistance) const{
+		return isReady()&&getForegroundRatio(rangeScan,begin,end,BGJumpDistance)<mParams.mMinForegroundRatio;
+	}
+
+	/**
+	 * copies the learned background into a scan, so it can be used with the offline functions
+	 * like filterSmallFGSegments() or getFGClassifikation()
+	 */
+	void fillBackgroundModel(RangeScanWithBackgroundModel & rangeScan) const;
+
+private:
+	void recalculateBeam(uint beam);
+
+	BackgroundModelParams mParams;
+	uint mBeams;
+	float mStartAngle,mDeltaAngle;
+
+	std::vector<float> mHistory; ///< ring buffer of mWindowSize scans, NaN for invalid beams
+	uint mHistoryCount; ///< scans in the ring buffer
+	uint mNextSlot; ///< slot of the ring buffer the next scan is written to
+	uint mScanCounter; ///< scans seen since the last update
+	std::vector<float> mBackground;
+	std::vector<float> mMedianBuffer;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif /* ONLINEBACKGROUNDMODEL_H_ */
@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file RangeScanView.h
+ *    header File for a non-owning view of the beams of a range scan
+ */
+
+#ifndef RANGESCANVIEW_H_
+#define RANGESCANVIEW_H_
+
+#include <cmath>
+#include <limits>
+#include <robot/RangeScan.h>
+
+namespace mira{
+namespace laserbasedobjectdetection{
+
+using mira::robot::RangeScan;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * the input of the detector: the ranges and the geometry of a scan, without owning the data
+ * any buffer of consecutive ranges can be processed in place (e.g. the ranges of a sensor_msgs::LaserScan),
+ * the data has to stay alive as long as the view is used
+ *
+ * the range codes are taken from mValid if given, otherwise they are derived from the ranges:
+ * NaN is RangeScan::Invalid, ranges below mMinimumRange are RangeScan::BelowMinimum and
+ * ranges above mMaximumRange are RangeScan::AboveMaximum
+ */
+struct RangeScanView{
+	RangeScanView() :
+		mRange(NULL), mSize(0), mStartAngle(0.0f), mDeltaAngle(0.0f),
+		mMinimumRange(-std::numeric_limits<float>::infinity()),
+		mMaximumRange(std::numeric_limits<float>::infinity()), mValid(NULL){}
+
+	RangeScanView(float const* range,uint size,float startAngle,float deltaAngle,
+	              float minimumRange,float maximumRange,uint16 const* valid=NULL) :
+		mRange(range), mSize(size), mStartAngle(startAngle), mDeltaAngle(deltaAngle),
+		mMinimumRange(minimumRange), mMaximumRange(maximumRange), mValid(valid){}
+
+	/**
+	 * the view of a mira range scan, implicit so all functions taking a view also take a RangeScan
+	 * scans without range codes (valid.size()!=range.size()) are treated as valid except for NaN ranges
+	 */
+	RangeScanView(RangeScan const& rangeScan) :
+		mRange(rangeScan.range.empty() ? NULL : &rangeScan.range[0]), mSize(rangeScan.range.size()),
+		mStartAngle(rangeScan.startAngle), mDeltaAngle(rangeScan.deltaAngle),
+		mMinimumRange(-std::numeric_limits<float>::infinity()),
+		mMaximumRange(std::numeric_limits<float>::infinity()),
+		mValid(rangeScan.valid.size()==rangeScan.range.size()&&!rangeScan.valid.empty() ? &rangeScan.valid[0] : NULL){}
+
+	uint inline size() const {return mSize;}
+	bool inline empty() const {return mSize==0;}
+
+	float inline operator[](uint i) const {return mRange[i];}
+
+	float inline getAngle(uint i) const {return mStartAngle+mDeltaAngle*(float)i;}
+
+	float inline getEndAngle() const {return mStartAngle+mDeltaAngle*(float)(mSize-1);}
+
+	/**
+	 * @return the RangeScan::RangeCode of the beam i
+	 */
+	uint16 inline getRangeCode(uint i) const {
+		if(mValid!=NULL)
+			return mValid[i];
+		float range=mRange[i];
+		if(std::isnan(range))
+			return RangeScan::Invalid;
+		if(range<mMinimumRange)
+			return RangeScan::BelowMinimum;
+		if(range>mMaximumRange)
+			return RangeScan::AboveMaximum;
+		return RangeScan::Valid;
+	}
+
+	/**
+	 * @return true if the beam i is RangeScan::Valid
+	 */
+	bool inline isValid(uint i) const {return getRangeCode(i)==RangeScan::Valid;}
+
+	float const* mRange; ///< the ranges of the beams in [m]
+	uint mSize; ///< the number of beams
+	float mStartAngle; ///< the angle of the first beam
+	float mDeltaAngle; ///< the angle between two beams
+	float mMinimumRange; ///< ranges below are too close, only used without mValid
+	float mMaximumRange; ///< ranges above are out of range, only used without mValid
+	uint16 const* mValid; ///< the range codes of the beams, NULL if they are derived from the ranges
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif /* RANGESCANVIEW_H_ */
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file SegmentPreFilter.h
+ *    header File for the geometric pre-filter of segment candidates
+ */
+
+#ifndef SEGMENTPREFILTER_H_
+#define SEGMENTPREFILTER_H_
+
+#include <Segmentation.h>
+#include <SegmentPreFilterParams.h>
+
+namespace mira{
+namespace laserbasedobjectdetection{
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * the cheap geometric properties of a segment the pre-filter decides on
+ */
+struct SegmentShape{
+	float mWidth; ///< distance between the first and the last point
+	float mNormalizedPointCount; ///< points*mean range*angular resolution
+	float mMeanRange; ///< mean range of the beams
+	float mLineResidual; ///< rms distance of the points to their fitted line
+};
+
+/**
+ * rejects segment candidates which obviously can not be one of the trained objects
+ * (e.g. long wall segments) before the bounding box and its features are calculated
+ */
+class SegmentPreFilter{
+public:
+	SegmentPreFilter(){}
+
+	void initialize(SegmentPreFilterParams const& params){
+		mParams=params;
+	}
+
+	bool inline isEnabled() const {return mParams.mEnabled;}
+
+	SegmentPreFilterParams const& getParams() const {return mParams;}
+
+	/**
+	 * @param rangeScan the scan the candidate was extracted from
+	 * @param candidate the segment to be checked
+	 * @return true if the candidate has to be classified, false if it can be rejected
+	 */
+	bool accept(RangeScanView const& rangeScan,SegmentCandidate const& candidate) const;
+
+	/**
+	 * the same tests on the shape of a segment, e.g. to evaluate learned thresholds on training segments
+	 * @param shape the shape including its line residual
+	 */
+	bool accept(SegmentShape const& shape) const;
+
+	/**
+	 * calculates the shape of the beams [begin,end) of the range scan
+	 * the line residual is only calculated if withLineResidual is true (0 else)
+	 */
+	static SegmentShape getShape(RangeScanView const& rangeScan,uint begin,uint end,bool withLineResidual);
+
+	/**
+	 * calculates the shape of a segment, the same way as for the beams of a range scan
+	 * @param angularResolution the angular resolution of the sensor in radians
+	 */
+	static SegmentShape getShape(RangeSegment const& segment,float angularResolution);
+
+	/**
+	 * learns thresholds from labeled training segments, such that every foreground segment passes the filter
+	 * @param segments labeled segments e.g. from getLabeledRangeSegments(), only FG segments are used
+	 * @param angularResolution the angular resolution of the sensor in radians
+	 * @param linearityMinWidth the width from which on the linearity test is applied
+	 * @param margin relative safety margin that is added to the learned bounds (e.g. 0.1 for 10%)
+	 */
+	static SegmentPreFilterParams learnParams(std::vector<RangeSegmentLabeled> const& segments,
+	                                          float angularResolution,
+	                                          float linearityMinWidth,
+	                                          float margin);
+
+private:
+	SegmentPreFilterParams mParams;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif /* SEGMENTPREFILTER_H_ */
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file SegmentPreFilterParams.h
+ *    header File for the parameters of the geometric segment pre-filter
+ */
+
+#ifndef SEGMENTPREFILTERPARAMS_H_
+#define SEGMENTPREFILTERPARAMS_H_
+
+#include <limits>
+
+struct SegmentPreFilterParams{
+	SegmentPreFilterParams(){
+		mEnabled=false;
+		mMaxSegmentWidth=std::numeric_limits<float>::max();
+		mMinNormalizedPointCount=0.0f;
+		mMaxNormalizedPointCount=std::numeric_limits<float>::max();
+		mLinearityMinWidth=std::numeric_limits<float>::max();
+		mMinLineResidual=0.0f;
+	}
+
+    template<typename Reflector>
+    void reflect(Reflector& r) {
+    	r.member("Enabled", mEnabled, "");
+    	r.member("MaxSegmentWidth", mMaxSegmentWidth, "");
+    	r.member("MinNormalizedPointCount", mMinNormalizedPointCount, "");
+    	r.member("MaxNormalizedPointCount", mMaxNormalizedPointCount, "");
+    	r.member("LinearityMinWidth", mLinearityMinWidth, "");
+    	r.member("MinLineResidual", mMinLineResidual, "");
+    }
+
+    bool mEnabled;
+    float mMaxSegmentWidth; ///< maximum distance between the first and the last point of a segment [m]
+    float mMinNormalizedPointCount; ///< minimum of points*range*angular resolution, the arc length covered by the beams [m]
+    float mMaxNormalizedPointCount; ///< maximum of points*range*angular resolution [m]
+    float mLinearityMinWidth; ///< the linearity test is only applied to segments at least this wide [m]
+    float mMinLineResidual; ///< minimum rms distance of the points to their fitted line [m]
+};
+
+#endif /* SEGMENTPREFILTERPARAMS_H_ */
@@ -46,7 +46,11 @@
  * @date   2014/08/22
  */
 
+#ifndef SEGMENTATION_H_
+#define SEGMENTATION_H_
+
 #include <RangeScanWithBackgroundModel.h>
+#include <RangeScanView.h>
 #include <geometry/Point.h>
 
 using namespace mira;
@@ -57,6 +61,20 @@ namespace laserbasedobjectdetection{
 
 ///////////////////////////////////////////////////////////////////////////////
 
+/**
+ * a segment of the consecutive beams [mBegin,mEnd) of a range scan and its center
+ */
+struct SegmentCandidate{
+	SegmentCandidate(){}
+	SegmentCandidate(Point2f const& center,uint begin,uint end) : mCenter(center), mBegin(begin), mEnd(end){}
+
+	uint inline size() const {return mEnd-mBegin;}
+
+	Point2f mCenter;
+	uint mBegin;
+	uint mEnd;
+};
+
 void filterSmallFGSegments(RangeScanWithBackgroundModel & rangeScan,uint const& minSegmentPoints,float const& jumpDistance,float const& BGJumpDistance);
 
 Point2f getGroundTruth(RangeScanWithBackgroundModel const& rangeScan,float const& backgroundJD);
@@ -67,13 +85,40 @@ std::vector<Point2f> getPoints(RangeScan const& rangeScan);
 
 std::vector<bool> getFGClassifikation(RangeScanWithBackgroundModel const& rangeScan,float const& BGJumpDiastance);
 
-std::vector<uint> getBreakPoints(RangeScan const& rangeScan,float const& jumpDistance);
+std::vector<uint> getBreakPoints(RangeScanView const& rangeScan,float const& jumpDistance);
+
+/**
+ * same as above, the break points are written to oBreakPoints, so its memory can be reused
+ */
+void getBreakPoints(RangeScanView const& rangeScan,float const& jumpDistance,std::vector<uint> & oBreakPoints);
 
 std::vector<RangeSegment> getRangeSegments(RangeScan const& rangeScan,float JumpDistance);
 
 std::vector<Point2f> getRangeSegmentsCenter(RangeScan const& rangeScan,float JumpDistance,uint minSegmentSize);
 
+/**
+ * same as above, segments consisting of invalid beams are skipped
+ * @param oInvalidSegments number of skipped segments that would have been large enough for a candidate
+ */
+std::vector<Point2f> getRangeSegmentsCenter(RangeScan const& rangeScan,float JumpDistance,uint minSegmentSize,uint & oInvalidSegments);
+
+/**
+ * returns the segments with at least minSegmentSize valid beams together with their beam intervals
+ * @param oInvalidSegments number of skipped segments that would have been large enough for a candidate
+ */
+std::vector<SegmentCandidate> getSegmentCandidates(RangeScanView const& rangeScan,float JumpDistance,uint minSegmentSize,uint & oInvalidSegments);
+
+/**
+ * same as above without allocations once the buffers are large enough
+ * @param oCandidates the candidates
+ * @param ioBreakPoints buffer for the break points
+ */
+void getSegmentCandidates(RangeScanView const& rangeScan,float JumpDistance,uint minSegmentSize,uint & oInvalidSegments,
+                          std::vector<SegmentCandidate> & oCandidates,std::vector<uint> & ioBreakPoints);
+
 ///////////////////////////////////////////////////////////////////////////////
 
 }
 }
+
+#endif /* SEGMENTATION_H_ */
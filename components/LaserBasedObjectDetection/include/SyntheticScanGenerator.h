@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file SyntheticScanGenerator.h
+ *    header File for the generator of synthetic range scans for load tests
+ */
+
+#ifndef SYNTHETICSCANGENERATOR_H_
+#define SYNTHETICSCANGENERATOR_H_
+
+#include <random>
+#include <vector>
+
+#include <robot/RangeScan.h>
+#include <geometry/Point.h>
+#include <SyntheticScanParams.h>
+
+namespace mira{
+namespace laserbasedobjectdetection{
+
+using mira::robot::RangeScan;
+
+///////////////////////////////////////////////////////////////////////////////
+
+/**
+ * an object placed in a synthetic scan, the ground truth of the scan
+ */
+struct SyntheticObject{
+	enum Type{LEGS=0,WHEELCHAIR=1,WALKER=2,CLUTTER=3};
+
+	SyntheticObject(){}
+	SyntheticObject(Type type,Point2f const& position,float orientation) :
+		mType(type), mPosition(position), mOrientation(orientation){}
+
+	Type mType;
+	Point2f mPosition; ///< center of the person or of the clutter object
+	float mOrientation; ///< [rad] direction the person is facing
+};
+
+/**
+ * generates range scans of a room with randomly placed people, wheelchairs, walkers and clutter
+ * the objects are built from circles (legs, casters, walker feet) and line segments (walls, wheels),
+ * every scan gets new random positions
+ */
+class SyntheticScanGenerator{
+public:
+	SyntheticScanGenerator(uint32_t seed=0);
+
+	void initialize(SyntheticScanParams const& params);
+
+	/**
+	 * @param oObjects if not NULL the placed objects are stored
+	 */
+	void generate(RangeScan & oScan,std::vector<SyntheticObject> * oObjects=NULL);
+
+private:
+	struct Circle{
+		Point2f mCenter;
+		float mRadius;
+	};
+
+	struct LineSegment{
+		Point2f mBegin;
+		Point2f mEnd;
+	};
+
+	/**
+	 * @return a random position in front of the sensor, inside the room
+	 */
+	Point2f getRandomPosition();
+
+	void addCircle(Point2f const& center,float orientation,Point2f const& offset,float radius);
+
+	void addLineSegment(Point2f const& center,float orientation,Point2f const& begin,Point2f const& end);
+
+	void addObject(SyntheticObject const& object);
+
+	/**
+	 * @return the range of the first intersection of the beam with a circle or a line segment, infinity if nothing is hit
+	 */
+	float castBeam(float angle) const;
+
+private:
+	SyntheticScanParams mParams;
+	std::mt19937 mRandom;
+	std::vector<Circle> mCircles;
+	std::vector<LineSegment> mLineSegments;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif /* SYNTHETICSCANGENERATOR_H_ */
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file SyntheticScanParams.h
+ *    header File for the parameters of the synthetic scan generator
+ */
+
+#ifndef SYNTHETICSCANPARAMS_H_
+#define SYNTHETICSCANPARAMS_H_
+
+#include <sys/types.h>
+#include <cmath>
+
+struct SyntheticScanParams{
+	SyntheticScanParams(){
+		mBeams=1080;
+		mFieldOfView=1.5f*M_PI;
+		mMinimumRange=0.02f;
+		mMaximumRange=30.0f;
+		mNoise=0.01f;
+		mDropoutRate=0.0f;
+		mWalls=true;
+		mRoomLength=20.0f;
+		mRoomWidth=8.0f;
+		mPeople=5;
+		mWheelchairs=1;
+		mWalkers=1;
+		mClutter=5;
+		mMinDistance=0.5f;
+		mMaxDistance=10.0f;
+	}
+
+    template<typename Reflector>
+    void reflect(Reflector& r) {
+    	r.member("Beams", mBeams, "");
+    	r.member("FieldOfView", mFieldOfView, "");
+    	r.member("MinimumRange", mMinimumRange, "");
+    	r.member("MaximumRange", mMaximumRange, "");
+    	r.member("Noise", mNoise, "");
+    	r.member("DropoutRate", mDropoutRate, "");
+    	r.member("Walls", mWalls, "");
+    	r.member("RoomLength", mRoomLength, "");
+    	r.member("RoomWidth", mRoomWidth, "");
+    	r.member("People", mPeople, "");
+    	r.member("Wheelchairs", mWheelchairs, "");
+    	r.member("Walkers", mWalkers, "");
+    	r.member("Clutter", mClutter, "");
+    	r.member("MinDistance", mMinDistance, "");
+    	r.member("MaxDistance", mMaxDistance, "");
+    }
+
+    uint mBeams; ///< number of beams, e.g. 3600 for 0.1 degree over 360 degree
+    float mFieldOfView; ///< [rad], centered around the x axis of the sensor
+    float mMinimumRange; ///< [m] shorter ranges are RangeScan::BelowMinimum
+    float mMaximumRange; ///< [m] longer ranges are RangeScan::AboveMaximum
+    float mNoise; ///< [m] standard deviation of the gaussian range noise
+    float mDropoutRate; ///< fraction of the beams which are RangeScan::Invalid
+    bool mWalls; ///< a rectangular room around the sensor, without walls the beams hit nothing
+    float mRoomLength; ///< [m] distance to the wall in front of the sensor, the wall behind is 2m away
+    float mRoomWidth; ///< [m] the sensor is in the middle between the side walls
+    uint mPeople; ///< people without walking aid, i.e. two legs
+    uint mWheelchairs; ///< people in a wheelchair
+    uint mWalkers; ///< people with a walker
+    uint mClutter; ///< round objects like pillars or bins
+    float mMinDistance; ///< [m] minimum distance of the objects to the sensor
+    float mMaxDistance; ///< [m] maximum distance of the objects to the sensor
+};
+
+#endif /* SYNTHETICSCANPARAMS_H_ */
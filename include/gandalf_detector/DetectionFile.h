@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file DetectionFile.h
+ *    text file with the detections of the scans of a bag file
+ */
+
+#ifndef GANDALF_DETECTOR_DETECTIONFILE_H_
+#define GANDALF_DETECTOR_DETECTIONFILE_H_
+
+#include <istream>
+#include <ostream>
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <sensor_msgs/LaserScan.h>
+
+#include <GDIFDetection.h>
+
+namespace gandalf_detector {
+
+/**
+ * one line of a detection file
+ */
+struct DetectionFileEntry{
+	std_msgs::Header mHeader; ///< stamp and frame_id of the scan
+	uint64_t mScan; ///< index of the scan in the processed bag files
+	GDIFDetection mDetection;
+};
+
+/**
+ * writes the comment line with the column names, every detection is one line with the columns
+ * stamp (sec.nsec) frame_id scan x y label margin path depth, scan is the index of the scan in the processed bag files
+ * scans without detections have no line
+ */
+inline void writeDetectionFileHeader(std::ostream& out){
+	out << "# stamp frame_id scan x y label margin path depth\n";
+}
+
+inline void writeDetections(std::ostream& out, std_msgs::Header const& header, uint64_t scanIndex,
+                            std::vector<GDIFDetection> const& detections){
+	// 9 significant digits, so the floats are read back exactly
+	std::streamsize precision = out.precision(9);
+	for(uint i = 0; i < detections.size(); ++i){
+		GDIFDetection const& detection = detections[i];
+		out << header.stamp.sec << "." << std::setw(9) << std::setfill('0') << header.stamp.nsec << std::setfill(' ')
+		    << " " << header.frame_id << " " << scanIndex
+		    << " " << detection.mPosition.x() << " " << detection.mPosition.y()
+		    << " " << (int)detection.mLabel << " " << detection.mMargin
+		    << " " << detection.mPath << " " << (int)detection.mDepth << "\n";
+	}
+	out.precision(precision);
+}
+
+/**
+ * reads a file written with writeDetectionFileHeader() and writeDetections()
+ * @return false if a line could not be parsed, oEntries contains the lines before
+ */
+inline bool readDetectionFile(std::istream& in, std::vector<DetectionFileEntry>& oEntries){
+	std::string line;
+	while(std::getline(in, line)){
+		if(line.empty() || line[0] == '#')
+			continue;
+		std::istringstream stream(line);
+		DetectionFileEntry entry;
+		char separator;
+		float x, y;
+		int label, depth;
+		stream >> entry.mHeader.stamp.sec >> separator >> entry.mHeader.stamp.nsec >> entry.mHeader.frame_id >> entry.mScan
+		       >> x >> y >> label >> entry.mDetection.mMargin >> entry.mDetection.mPath >> depth;
+		if(!stream || separator != '.')
+			return false;
+		entry.mDetection.mPosition = mira::Point2f(x, y);
+		entry.mDetection.mLabel = (StageLabel)label;
+		entry.mDetection.mDepth = depth;
+		oEntries.push_back(entry);
+	}
+	return true;
+}
+
+}
+
+#endif /* GANDALF_DETECTOR_DETECTIONFILE_H_ */
@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file DetectionMessages.h
+ *    conversion of detections to pose arrays and rviz markers
+ */
+
+#ifndef GANDALF_DETECTOR_DETECTIONMESSAGES_H_
+#define GANDALF_DETECTOR_DETECTIONMESSAGES_H_
+
+#include <std_msgs/Header.h>
+#include <std_msgs/ColorRGBA.h>
+#include <geometry_msgs/PoseArray.h>
+#include <visualization_msgs/Marker.h>
+#include <gandalf_detector/LabeledDetections.h>
+
+#include <GDIFDetection.h>
+
+namespace gandalf_detector {
+
+/**
+ * one color per StageLabel, dark colors for people, bright ones for walking aids
+ */
+inline std::vector<std_msgs::ColorRGBA> getLabelColorPalette(){
+	std::vector<std_msgs::ColorRGBA> colorPalette;
+	std_msgs::ColorRGBA color;
+	color.r = 0.5; color.g =  0.0; color.b = 0.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.5; color.g =  0.5; color.b = 0.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.0; color.g =  0.5; color.b = 0.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.0; color.g =  0.5; color.b = 0.5; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.0; color.g =  0.0; color.b = 0.5; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.5; color.g =  0.0; color.b = 0.5; color.a =  1.0;
+	colorPalette.push_back(color);
+
+	color.r = 1.0; color.g =  0.0; color.b = 0.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 1.0; color.g =  1.0; color.b = 0.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.0; color.g =  1.0; color.b = 0.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.0; color.g =  1.0; color.b = 1.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 0.0; color.g =  0.0; color.b = 1.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	color.r = 1.0; color.g =  0.0; color.b = 1.0; color.a =  1.0;
+	colorPalette.push_back(color);
+	return colorPalette;
+}
+
+/**
+ * the sphere list marker of the detections, without header and points
+ */
+inline visualization_msgs::Marker getDetectionMarker(std::string const& ns = "people_detections"){
+	visualization_msgs::Marker marker;
+	marker.ns = ns;
+	marker.id = 0;
+	marker.type = visualization_msgs::Marker::SPHERE_LIST;
+	//marker.action = visualization_msgs::Marker::ADD;
+	marker.action = visualization_msgs::Marker::MODIFY;
+	marker.pose.orientation.w = 1.0;
+	marker.scale.x = 0.3;
+	marker.scale.y = 0.3;
+	marker.scale.z = 0.1;
+	marker.color.a = 1.0;
+	marker.color.r = 0.0;
+	marker.color.g = 1.0;
+	marker.color.b = 0.0;
+	//marker.lifetime = 10;
+	//marker.frame_locked = true;
+	return marker;
+}
+
+/**
+ * fills the pose array and the points of the marker with the detections
+ * the poses keep the orientation of the marker
+ */
+inline void fillDetectionMessages(std_msgs::Header const& header,
+                                  std::vector<GDIFDetection> const& detections,
+                                  std::vector<std_msgs::ColorRGBA> const& colorPalette,
+                                  geometry_msgs::PoseArray& oPoseArray,
+                                  visualization_msgs::Marker& ioMarker){
+	ioMarker.header = header;
+	ioMarker.points.clear();
+	ioMarker.colors.clear();
+
+	oPoseArray.header = header;
+	oPoseArray.poses.clear();
+
+	geometry_msgs::Pose pose;
+	pose = ioMarker.pose;
+	geometry_msgs::Point point;
+	point.z = 0.0;
+
+	for(uint i=0;i<detections.size();i++){
+		pose.position.x = detections[i].mPosition.x();
+		pose.position.y = detections[i].mPosition.y();
+		oPoseArray.poses.push_back(pose);
+
+		point.x = detections[i].mPosition.x();
+		point.y = detections[i].mPosition.y();
+
+		ioMarker.points.push_back(point);
+		ioMarker.colors.push_back(colorPalette[detections[i].mLabel % colorPalette.size()]);
+	}
+}
+
+/**
+ * fills the compact message with positions, labels, margins and tree paths of the detections
+ */
+inline void fillLabeledDetections(std_msgs::Header const& header,
+                                  std::vector<GDIFDetection> const& detections,
+                                  gandalf_detector::LabeledDetections& oDetections){
+	oDetections.header = header;
+	uint n = detections.size();
+	oDetections.x.resize(n);
+	oDetections.y.resize(n);
+	oDetections.label.resize(n);
+	oDetections.margin.resize(n);
+	oDetections.path.resize(n);
+	oDetections.depth.resize(n);
+	for(uint i = 0; i < n; ++i){
+		oDetections.x[i] = detections[i].mPosition.x();
+		oDetections.y[i] = detections[i].mPosition.y();
+		oDetections.label[i] = detections[i].mLabel;
+		oDetections.margin[i] = detections[i].mMargin;
+		oDetections.path[i] = detections[i].mPath;
+		oDetections.depth[i] = detections[i].mDepth;
+	}
+}
+
+}
+
+#endif /* GANDALF_DETECTOR_DETECTIONMESSAGES_H_ */
@@ -0,0 +1,101 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file DetectionPublishers.h
+ *    the output topics of the detector nodes
+ */
+
+#ifndef GANDALF_DETECTOR_DETECTIONPUBLISHERS_H_
+#define GANDALF_DETECTOR_DETECTIONPUBLISHERS_H_
+
+#include <ros/ros.h>
+
+#include <gandalf_detector/DetectionMessages.h>
+
+namespace gandalf_detector {
+
+/**
+ * publishes the detections as LabeledDetections on <prefix>Detections and for the visualization
+ * as pose array on <prefix>HypothesesPoses and as marker on <prefix>HypothesesMarkers
+ *
+ * the messages are published as shared pointers and not modified afterwards, so subscribers in the
+ * same nodelet manager receive them without serialization. Messages without subscribers are not built.
+ */
+class DetectionPublishers{
+public:
+	void advertise(ros::NodeHandle& nodeHandle, std::string const& prefix = ""){
+		mDetectionsTopic = nodeHandle.advertise<LabeledDetections>(prefix + "Detections", 1000);
+		mHypothesesPoseArrayTopic = nodeHandle.advertise<geometry_msgs::PoseArray>(prefix + "HypothesesPoses", 1000);
+		mHypothesesMarkerTopic = nodeHandle.advertise<visualization_msgs::Marker>(prefix + "HypothesesMarkers", 1000);
+	}
+
+	/**
+	 * @param marker the template of the marker, without header and points
+	 */
+	void publish(std_msgs::Header const& header, std::vector<GDIFDetection> const& detections,
+	             std::vector<std_msgs::ColorRGBA> const& colorPalette, visualization_msgs::Marker const& marker) const {
+		if(mDetectionsTopic.getNumSubscribers() > 0){
+			LabeledDetectionsPtr labeledDetections(new LabeledDetections());
+			fillLabeledDetections(header, detections, *labeledDetections);
+			mDetectionsTopic.publish(labeledDetections);
+		}
+		bool publishPoses = mHypothesesPoseArrayTopic.getNumSubscribers() > 0;
+		bool publishMarker = mHypothesesMarkerTopic.getNumSubscribers() > 0;
+		if(publishPoses || publishMarker){
+			geometry_msgs::PoseArrayPtr poseArray(new geometry_msgs::PoseArray());
+			visualization_msgs::MarkerPtr filledMarker(new visualization_msgs::Marker(marker));
+			fillDetectionMessages(header, detections, colorPalette, *poseArray, *filledMarker);
+			if(publishPoses)
+				mHypothesesPoseArrayTopic.publish(poseArray);
+			if(publishMarker)
+				mHypothesesMarkerTopic.publish(filledMarker);
+		}
+	}
+
+private:
+	ros::Publisher mDetectionsTopic;
+	ros::Publisher mHypothesesPoseArrayTopic;
+	ros::Publisher mHypothesesMarkerTopic;
+};
+
+}
+
+#endif /* GANDALF_DETECTOR_DETECTIONPUBLISHERS_H_ */
@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file DetectorNodeParams.h
+ *    reads the parameters of the detector from the ROS parameter server or another parameter source
+ */
+
+#ifndef GANDALF_DETECTOR_DETECTORNODEPARAMS_H_
+#define GANDALF_DETECTOR_DETECTORNODEPARAMS_H_
+
+#include <ros/ros.h>
+#include <ros/package.h>
+
+#include <boost/filesystem.hpp>
+
+#include <GDIFDetectorTree.h>
+#include <AdaboostClassifierNodeParams.h>
+
+namespace gandalf_detector {
+
+using namespace mira::laserbasedobjectdetection;
+
+/**
+ * all parameters needed to initialize a GDIFDetectorTree
+ */
+struct DetectorNodeParams{
+	/// the nodes of the classifier tree, the root is the last one
+	std::vector<boost::shared_ptr<AdaboostClassifierNodeParams> > mClassifierParams;
+	SegmentationParams mSegmentationParams;
+	BoundingBoxParams mBoundingBoxParams;
+	SegmentPreFilterParams mPreFilterParams;
+	BackgroundModelParams mBackgroundModelParams;
+	DetectionMergerParams mDetectionMergerParams;
+	CandidateBudgetParams mCandidateBudgetParams;
+	RegionOfInterestParams mRegionOfInterestParams;
+	ParallelParams mParallelParams;
+	/// names of the additional operating points, their thresholds are part of the classifier params
+	std::vector<std::string> mOperatingPoints;
+	/// names of the additional classifier trees which share the segmentation and the features
+	std::vector<std::string> mConfigurations;
+	/// the nodes of the classifier tree of each configuration, in the order of mConfigurations
+	std::vector<std::vector<boost::shared_ptr<AdaboostClassifierNodeParams> > > mConfigurationClassifierParams;
+
+	boost::shared_ptr<AdaboostClassifierNodeParams> getRootClassifierParams() const {
+		if(mClassifierParams.empty())
+			return boost::shared_ptr<AdaboostClassifierNodeParams>();
+		return mClassifierParams.back();
+	}
+
+	/**
+	 * the parameters of a detector with the classifier tree of configuration k
+	 * the detector only classifies the candidates extracted by the default detector, so the stages
+	 * of the extraction are disabled and it classifies serially without thread pools
+	 */
+	DetectorNodeParams getConfigurationParams(uint32 k) const {
+		DetectorNodeParams tParams = *this;
+		tParams.mClassifierParams = mConfigurationClassifierParams[k];
+		tParams.mOperatingPoints.clear();
+		tParams.mConfigurations.clear();
+		tParams.mConfigurationClassifierParams.clear();
+		tParams.mPreFilterParams = SegmentPreFilterParams();
+		tParams.mBackgroundModelParams = BackgroundModelParams();
+		tParams.mRegionOfInterestParams = RegionOfInterestParams();
+		tParams.mBoundingBoxParams.mFeatureResolution = 0.0f;
+		tParams.mBoundingBoxParams.mGeometryTableSize = 0;
+		tParams.mParallelParams = ParallelParams();
+		return tParams;
+	}
+};
+
+/**
+ * replaces $(find package) in a path by the path of the package
+ */
+inline std::string resolvePath(const std::string& iPath){
+	std::size_t startPos = iPath.find("$(find ");
+
+	if(startPos == std::string::npos){
+		return iPath;
+	}
+	std::size_t endPos = iPath.find(")",startPos);
+
+	if(endPos == std::string::npos){
+		return iPath;
+	}
+	return iPath.substr(0,startPos) + ros::package::getPath(iPath.substr(startPos + 7, endPos - startPos - 7)) + iPath.substr(endPos+1);
+}
+
+/**
+ * reads a classifier tree, the root is the last node
+ * @param prefix the namespace of the tree parameters, e.g. "Walkers/" for Walkers/Thresholds
+ */
+template<typename ParamSource>
+inline void readClassifierParams(ParamSource& nh, std::string const& prefix, int featureVectorSize,
+                                 std::vector<boost::shared_ptr<AdaboostClassifierNodeParams> >& oClassifierParams){
+	std::vector<boost::shared_ptr<AdaboostClassifierNodeParams> >& tAdaboostClassifierNodeParams = oClassifierParams;
+	tAdaboostClassifierNodeParams.clear();
+
+	std::vector<double> tThresholds;
+	std::vector<string> tClassifierFiles;
+	std::vector<string> tDescriptions;
+	std::vector<int> tPosLabels;
+	std::vector<int> tNegLabels;
+	std::vector<int> tPosChilds;
+	std::vector<int> tNegChilds;
+
+	if(!nh.hasParam(prefix + "Thresholds")){
+		ROS_ERROR("no param %sthresholds", prefix.c_str());
+	}
+
+	if(!nh.getParam(prefix + "Thresholds", tThresholds)){
+		ROS_ERROR("could not get param %sthresholds", prefix.c_str());
+	}
+
+	nh.getParam(prefix + "ClassifierFiles", tClassifierFiles);
+	nh.getParam(prefix + "Descriptions", tDescriptions);
+	nh.getParam(prefix + "PosLabels", tPosLabels);
+	nh.getParam(prefix + "NegLabels", tNegLabels);
+	nh.getParam(prefix + "PosChilds", tPosChilds);
+	nh.getParam(prefix + "NegChilds", tNegChilds);
+
+	if(tThresholds.size() != tClassifierFiles.size()){
+		ROS_ERROR("tThresholds.size() [%d] != tClassifierFiles.size() [%d]", (int)tThresholds.size(), (int)tClassifierFiles.size());
+	}
+	if(tPosLabels.size() != tNegLabels.size()){
+		ROS_ERROR("tPosLabels.size() [%d] != tNegLabels.size() [%d]", (int)tPosLabels.size(), (int)tNegLabels.size());
+	}
+	if(tPosChilds.size() != tNegChilds.size()){
+		ROS_ERROR("tPosChilds.size() [%d] != tNegChilds.size() [%d]", (int)tPosChilds.size(), (int)tNegChilds.size());
+	}
+	if(tPosChilds.size() != tPosLabels.size()){
+		ROS_ERROR("tPosChilds.size() [%d] != tPosLabels.svn size() [%d]", (int)tPosChilds.size(), (int)tPosLabels.size());
+	}
+	if(tPosChilds.size() != tThresholds.size()){
+		ROS_ERROR("tPosChilds.size() [%d] != tThresholds.size() [%d]", (int)tPosChilds.size(), (int)tThresholds.size());
+	}
+
+	for(uint32 i = 0; i < tThresholds.size(); ++i){
+		boost::filesystem::path testPath(resolvePath(tClassifierFiles[i]));
+		if(!boost::filesystem::exists(testPath)){
+			ROS_ERROR("Could not find opencv classifier file: [%s]", testPath.string().c_str());
+		}
+		tAdaboostClassifierNodeParams.push_back(boost::shared_ptr<AdaboostClassifierNodeParams>(new AdaboostClassifierNodeParams((StageLabel) tPosLabels[i], (StageLabel) tNegLabels[i], tDescriptions[i], resolvePath(tClassifierFiles[i]), tThresholds[i], featureVectorSize)));
+	}
+	for(uint32 i = 0; i < tThresholds.size(); ++i){
+		if(tPosChilds[i] >= (int)tThresholds.size())
+			ROS_ERROR("tPosChilds[i] [%d] >=  tThresholds.size() [%d]", tPosChilds[i], (int)tThresholds.size());
+		if(tNegChilds[i] >= (int)tThresholds.size())
+			ROS_ERROR("tNegChilds[i] [%d] >=  tThresholds.size() [%d]", tNegChilds[i], (int)tThresholds.size());
+		if(tPosChilds[i] >= 0)
+			tAdaboostClassifierNodeParams[i]->mPosChild = tAdaboostClassifierNodeParams[tPosChilds[i]];
+		if(tNegChilds[i] >= 0)
+			tAdaboostClassifierNodeParams[i]->mNegChild = tAdaboostClassifierNodeParams[tNegChilds[i]];
+	}
+}
+
+/**
+ * reads the classifier tree, the segmentation, the bounding box and the optional stages
+ * from the parameters of the node handle
+ * @param nh a ros::NodeHandle or any other parameter source with its hasParam(), getParam() and param()
+ */
+template<typename ParamSource>
+inline void readDetectorNodeParams(ParamSource& nh, DetectorNodeParams& oParams){
+	int tInt;
+	double tDouble;
+
+	int tFeatureVectorSize;
+	nh.param("FeatureVectorSize", tFeatureVectorSize, 45);
+
+	readClassifierParams(nh, "", tFeatureVectorSize, oParams.mClassifierParams);
+
+	// additional operating points from the same classification, e.g. OperatingPoints: [Safety] with
+	// SafetyThresholds in the order of Thresholds
+	oParams.mOperatingPoints.clear();
+	nh.getParam("OperatingPoints", oParams.mOperatingPoints);
+	for(uint32 k = 0; k < oParams.mOperatingPoints.size(); ++k){
+		std::string tName = oParams.mOperatingPoints[k] + "Thresholds";
+		std::vector<double> tOperatingPointThresholds;
+		if(!nh.getParam(tName, tOperatingPointThresholds)){
+			ROS_ERROR("could not get param %s", tName.c_str());
+		}
+		if(tOperatingPointThresholds.size() != oParams.mClassifierParams.size()){
+			ROS_ERROR("%s.size() [%d] != tThresholds.size() [%d]", tName.c_str(), (int)tOperatingPointThresholds.size(), (int)oParams.mClassifierParams.size());
+		}
+		// missing thresholds are the ones of the default operating point
+		for(uint32 i = 0; i < oParams.mClassifierParams.size(); ++i){
+			double tThreshold = i < tOperatingPointThresholds.size() ? tOperatingPointThresholds[i] : oParams.mClassifierParams[i]->mThreshold;
+			oParams.mClassifierParams[i]->mOperatingPointThresholds.push_back(tThreshold);
+		}
+	}
+
+	// additional classifier trees evaluated on the same features, e.g. Configurations: [Walkers] with
+	// Walkers/Thresholds, Walkers/ClassifierFiles, ... like the default tree
+	oParams.mConfigurations.clear();
+	nh.getParam("Configurations", oParams.mConfigurations);
+	oParams.mConfigurationClassifierParams.resize(oParams.mConfigurations.size());
+	for(uint32 k = 0; k < oParams.mConfigurations.size(); ++k){
+		readClassifierParams(nh, oParams.mConfigurations[k] + "/", tFeatureVectorSize, oParams.mConfigurationClassifierParams[k]);
+	}
+
+	nh.param("JumpDistance", tDouble, 0.1);
+	oParams.mSegmentationParams.mJumpDistance = tDouble;
+	//ROS_INFO("jump distance [%f] ", mParams.mJumpDistance);
+	nh.param("MaxRange", tDouble, 10.0);
+	oParams.mSegmentationParams.mMaxRange = tDouble;
+	nh.param("BackgroundJumpDistance", tDouble, 0.2);
+	oParams.mSegmentationParams.mBackgroundJumpDistance = tDouble;
+	nh.param("MinSegmentSize", tInt, 3);
+	oParams.mSegmentationParams.mMinSegmentSize = tInt;
+	nh.param("BinQuantity", tInt, 15);
+	oParams.mBoundingBoxParams.mBinQuantity = tInt;
+	nh.param("BoxWidth", tDouble, 0.8);
+	oParams.mBoundingBoxParams.mBoxWidth = tDouble;
+	nh.param("BoxHeight", tDouble, 3.0);
+	oParams.mBoundingBoxParams.mBoxHeight = tDouble;
+	// the reference point is the center of a segment (0) or the most left point of a segment (1)
+	nh.param("BoxMode", tInt, 0);
+	oParams.mBoundingBoxParams.mBoxMode = (BoxMode)tInt;
+	nh.param("BoxFromLeftOffset", tDouble, -0.3);
+	oParams.mBoundingBoxParams.mBoxFromLeftOffset = tDouble;
+	nh.param("UseHighFreqFeats", oParams.mBoundingBoxParams.mUseHighFreqFeats, true);
+	// [rad] decimation of the beams of a box for high resolution scanners, 0 uses all beams
+	nh.param("FeatureResolution", tDouble, 0.0);
+	oParams.mBoundingBoxParams.mFeatureResolution = tDouble;
+	// the angles of the bins from a table over the inverse range of the box instead of atan2, 0 for exact angles
+	nh.param("BoxGeometryTableSize", tInt, 0);
+	oParams.mBoundingBoxParams.mGeometryTableSize = std::max(tInt, 0);
+	nh.param("BoxGeometryTableMinRange", tDouble, (double)oParams.mBoundingBoxParams.mGeometryTableMinRange);
+	oParams.mBoundingBoxParams.mGeometryTableMinRange = tDouble;
+
+	// geometric pre-filter, the thresholds should be learned with gandalf_learn_prefilter
+	nh.param("UsePreFilter", oParams.mPreFilterParams.mEnabled, false);
+	nh.param("PreFilterMaxSegmentWidth", tDouble, (double)oParams.mPreFilterParams.mMaxSegmentWidth);
+	oParams.mPreFilterParams.mMaxSegmentWidth = tDouble;
+	nh.param("PreFilterMinNormalizedPointCount", tDouble, (double)oParams.mPreFilterParams.mMinNormalizedPointCount);
+	oParams.mPreFilterParams.mMinNormalizedPointCount = tDouble;
+	nh.param("PreFilterMaxNormalizedPointCount", tDouble, (double)oParams.mPreFilterParams.mMaxNormalizedPointCount);
+	oParams.mPreFilterParams.mMaxNormalizedPointCount = tDouble;
+	nh.param("PreFilterLinearityMinWidth", tDouble, (double)oParams.mPreFilterParams.mLinearityMinWidth);
+	oParams.mPreFilterParams.mLinearityMinWidth = tDouble;
+	nh.param("PreFilterMinLineResidual", tDouble, (double)oParams.mPreFilterParams.mMinLineResidual);
+	oParams.mPreFilterParams.mMinLineResidual = tDouble;
+
+	// online background model, only for sensors which do not move
+	nh.param("UseBackgroundModel", oParams.mBackgroundModelParams.mEnabled, false);
+	nh.param("BackgroundModelMode", tInt, (int)BG_MAX);
+	oParams.mBackgroundModelParams.mMode = (BackgroundModelMode)tInt;
+	nh.param("BackgroundWindowSize", tInt, (int)oParams.mBackgroundModelParams.mWindowSize);
+	oParams.mBackgroundModelParams.mWindowSize = tInt;
+	nh.param("BackgroundUpdateInterval", tInt, (int)oParams.mBackgroundModelParams.mUpdateInterval);
+	oParams.mBackgroundModelParams.mUpdateInterval = tInt;
+	nh.param("BackgroundMinScans", tInt, (int)oParams.mBackgroundModelParams.mMinScans);
+	oParams.mBackgroundModelParams.mMinScans = tInt;
+	nh.param("BackgroundMinForegroundRatio", tDouble, (double)oParams.mBackgroundModelParams.mMinForegroundRatio);
+	oParams.mBackgroundModelParams.mMinForegroundRatio = tDouble;
+
+	// merging of nearby detections of the same label (e.g. the two legs of a person)
+	nh.param("MergeDetections", oParams.mDetectionMergerParams.mEnabled, false);
+	std::vector<int> tMergeLabels;
+	std::vector<double> tMergeRadii;
+	nh.getParam("MergeLabels", tMergeLabels);
+	nh.getParam("MergeRadii", tMergeRadii);
+	if(tMergeLabels.size() != tMergeRadii.size()){
+		ROS_ERROR("tMergeLabels.size() [%d] != tMergeRadii.size() [%d]", (int)tMergeLabels.size(), (int)tMergeRadii.size());
+	}
+	for(uint32 i = 0; i < tMergeLabels.size() && i < tMergeRadii.size(); ++i){
+		oParams.mDetectionMergerParams.mMergeRadius[tMergeLabels[i]] = tMergeRadii[i];
+	}
+
+	// real-time mode, bounds the candidates and the time per scan
+	nh.param("UseCandidateBudget", oParams.mCandidateBudgetParams.mEnabled, false);
+	nh.param("CandidatePriority", tInt, (int)PRIORITY_NEAREST);
+	oParams.mCandidateBudgetParams.mPriority = (CandidatePriority)tInt;
+	nh.param("MaxCandidates", tInt, (int)oParams.mCandidateBudgetParams.mMaxCandidates);
+	oParams.mCandidateBudgetParams.mMaxCandidates = std::max(tInt, 0);
+	nh.param("CandidateTimeBudget", tDouble, (double)oParams.mCandidateBudgetParams.mTimeBudget);
+	oParams.mCandidateBudgetParams.mTimeBudget = tDouble;
+	nh.param("CorridorWidth", tDouble, (double)oParams.mCandidateBudgetParams.mCorridorWidth);
+	oParams.mCandidateBudgetParams.mCorridorWidth = tDouble;
+	nh.param("CorridorLength", tDouble, (double)oParams.mCandidateBudgetParams.mCorridorLength);
+	oParams.mCandidateBudgetParams.mCorridorLength = tDouble;
+
+	// regions of interest, e.g. from a tracker, with a full scan every FullScanInterval scans
+	nh.param("UseRegionsOfInterest", oParams.mRegionOfInterestParams.mEnabled, false);
+	nh.param("FullScanInterval", tInt, (int)oParams.mRegionOfInterestParams.mFullScanInterval);
+	oParams.mRegionOfInterestParams.mFullScanInterval = std::max(tInt, 0);
+
+	// parallel processing of the candidates of a scan, scans with few candidates are processed serially
+	nh.param("ParallelThreads", tInt, (int)oParams.mParallelParams.mThreads);
+	oParams.mParallelParams.mThreads = std::max(tInt, 1);
+	nh.param("ParallelMinCandidates", tInt, (int)oParams.mParallelParams.mMinCandidates);
+	oParams.mParallelParams.mMinCandidates = std::max(tInt, 0);
+	nh.param("ParallelChunkTime", tDouble, (double)oParams.mParallelParams.mChunkTime);
+	oParams.mParallelParams.mChunkTime = tDouble;
+
+}
+
+/**
+ * loads the classifier tree of the parameters, e.g. to share it between detectors or to replace the tree of a running detector
+ * @param ioRegistry the models of a previously loaded tree, unchanged files are not loaded again
+ * @return an empty pointer if the parameters contain no tree or a classifier file does not exist
+ */
+inline boost::shared_ptr<AdaboostClassifierNode const> loadClassifier(DetectorNodeParams const& params, AdaboostModelRegistry& ioRegistry){
+	boost::shared_ptr<AdaboostClassifierNodeParams> tRootParams = params.getRootClassifierParams();
+	if(!tRootParams)
+		return boost::shared_ptr<AdaboostClassifierNode const>();
+	for(uint32 i = 0; i < params.mClassifierParams.size(); ++i){
+		if(!boost::filesystem::exists(params.mClassifierParams[i]->mOpenCvPath))
+			return boost::shared_ptr<AdaboostClassifierNode const>();
+	}
+	boost::shared_ptr<AdaboostClassifierNode> tClassifier(new AdaboostClassifierNode());
+	tClassifier->initialize(tRootParams, ioRegistry);
+	ROS_INFO("loaded [%d] of [%d] classifier models with [%d] kB in [%f] s", (int)ioRegistry.getLoadedModels(),
+			(int)ioRegistry.getModelCount(), (int)(ioRegistry.getBytes() / 1024), ioRegistry.getLoadTime());
+	return tClassifier;
+}
+
+inline boost::shared_ptr<AdaboostClassifierNode const> loadClassifier(DetectorNodeParams const& params){
+	AdaboostModelRegistry tRegistry;
+	return loadClassifier(params, tRegistry);
+}
+
+/**
+ * initializes the detector and all optional stages
+ */
+inline void initializeDetector(GDIFDetectorTree& detector, DetectorNodeParams const& params){
+	detector.inititalize(params.getRootClassifierParams(), params.mSegmentationParams, params.mBoundingBoxParams);
+	detector.setPreFilterParams(params.mPreFilterParams);
+	detector.setBackgroundModelParams(params.mBackgroundModelParams);
+	detector.setDetectionMergerParams(params.mDetectionMergerParams);
+	detector.setCandidateBudgetParams(params.mCandidateBudgetParams);
+	detector.setRegionOfInterestParams(params.mRegionOfInterestParams);
+	detector.setParallelParams(params.mParallelParams);
+}
+
+/**
+ * initializes the detector and all optional stages with an already loaded classifier tree
+ */
+inline void initializeDetector(GDIFDetectorTree& detector, DetectorNodeParams const& params,
+                               boost::shared_ptr<AdaboostClassifierNode const> classifier){
+	detector.inititalize(classifier, params.mSegmentationParams, params.mBoundingBoxParams);
+	detector.setPreFilterParams(params.mPreFilterParams);
+	detector.setBackgroundModelParams(params.mBackgroundModelParams);
+	detector.setDetectionMergerParams(params.mDetectionMergerParams);
+	detector.setCandidateBudgetParams(params.mCandidateBudgetParams);
+	detector.setRegionOfInterestParams(params.mRegionOfInterestParams);
+	detector.setParallelParams(params.mParallelParams);
+}
+
+}
+
+#endif /* GANDALF_DETECTOR_DETECTORNODEPARAMS_H_ */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file Diagnostics.h
+ *    helpers for the diagnostics of the detector nodes
+ */
+
+#ifndef GANDALF_DETECTOR_DIAGNOSTICS_H_
+#define GANDALF_DETECTOR_DIAGNOSTICS_H_
+
+#include <sstream>
+#include <diagnostic_msgs/KeyValue.h>
+#include <diagnostic_msgs/DiagnosticStatus.h>
+
+#include <gandalf_detector/LatencyHistogram.h>
+#include <GDIFDetectorStatistics.h>
+
+namespace gandalf_detector {
+
+using mira::laserbasedobjectdetection::GDIFDetectorTotals;
+
+template<typename T>
+inline diagnostic_msgs::KeyValue makeKeyValue(std::string const& key, T const& value){
+	diagnostic_msgs::KeyValue keyValue;
+	keyValue.key = key;
+	std::ostringstream stream;
+	stream << value;
+	keyValue.value = stream.str();
+	return keyValue;
+}
+
+/**
+ * adds "<name> p50", "p95", "p99" and "max" of the histogram snapshot to the status
+ * @param scale factor for the values, e.g. 1e-3 for [ns] to [us]
+ */
+inline void addPercentiles(diagnostic_msgs::DiagnosticStatus& status, std::string const& name,
+                           LatencyHistogram::Snapshot const& snapshot, double scale){
+	status.values.push_back(makeKeyValue(name + " p50", snapshot.getPercentile(50.0) * scale));
+	status.values.push_back(makeKeyValue(name + " p95", snapshot.getPercentile(95.0) * scale));
+	status.values.push_back(makeKeyValue(name + " p99", snapshot.getPercentile(99.0) * scale));
+	status.values.push_back(makeKeyValue(name + " max", snapshot.mMax * scale));
+}
+
+/**
+ * adds the funnel of the candidates as means per scan, the evaluations of the tree nodes per classified
+ * candidate ("node <index>", depth first from the root) and the labels per scan ("label <StageLabel>")
+ */
+inline void addDetectorTotals(diagnostic_msgs::DiagnosticStatus& status, GDIFDetectorTotals const& totals){
+	double scans = std::max<double>(totals.mScans, 1.0);
+	double classified = std::max<double>(totals.mClassified, 1.0);
+	status.values.push_back(makeKeyValue("scans", totals.mScans));
+	status.values.push_back(makeKeyValue("segments", totals.mSegments / scans));
+	status.values.push_back(makeKeyValue("small segments", totals.mSmallSegments / scans));
+	status.values.push_back(makeKeyValue("invalid beam segments", totals.mInvalidBeamSegments / scans));
+	status.values.push_back(makeKeyValue("candidates", totals.mCandidates / scans));
+	status.values.push_back(makeKeyValue("out of range", totals.mOutOfRange / scans));
+	status.values.push_back(makeKeyValue("outside regions of interest", totals.mOutsideRegionsOfInterest / scans));
+	status.values.push_back(makeKeyValue("background", totals.mBackgroundRejected / scans));
+	status.values.push_back(makeKeyValue("pre-filtered", totals.mPreFilterRejected / scans));
+	status.values.push_back(makeKeyValue("invalid boxes", totals.mInvalidBoxes / scans));
+	status.values.push_back(makeKeyValue("skipped", totals.mSkippedCandidates / scans));
+	status.values.push_back(makeKeyValue("classified", totals.mClassified / scans));
+	for(uint n = 0; n < totals.mNodeEvaluations.size(); ++n){
+		std::ostringstream key;
+		key << "node " << n << " evaluations per candidate";
+		status.values.push_back(makeKeyValue(key.str(), totals.mNodeEvaluations[n] / classified));
+	}
+	for(uint l = 0; l < totals.mLabels.size(); ++l){
+		if(totals.mLabels[l] == 0)
+			continue;
+		std::ostringstream key;
+		key << "label " << (int)l - 1;
+		status.values.push_back(makeKeyValue(key.str(), totals.mLabels[l] / scans));
+	}
+}
+
+}
+
+#endif /* GANDALF_DETECTOR_DIAGNOSTICS_H_ */
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file GDIFMultiObjectDetectorNode.h
+ *    header File for the ROS interface of the detector, used by the nodelet and the node
+ */
+
+#ifndef GANDALF_DETECTOR_GDIFMULTIOBJECTDETECTORNODE_H_
+#define GANDALF_DETECTOR_GDIFMULTIOBJECTDETECTORNODE_H_
+
+#include <ros/ros.h>
+#include <sensor_msgs/LaserScan.h>
+#include <visualization_msgs/Marker.h>
+
+#include <GDIFDetectorTree.h>
+
+#include <boost/thread.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <gandalf_detector/Mailbox.h>
+#include <gandalf_detector/DetectorNodeParams.h>
+#include <gandalf_detector/DetectionPublishers.h>
+#include <gandalf_detector/RegionsOfInterest.h>
+#include <gandalf_detector/ModelReloader.h>
+#ifdef GANDALF_STAGE_TIMING
+#include <gandalf_detector/LatencyHistogram.h>
+#endif
+
+namespace gandalf_detector {
+
+/**
+ * the result of the extraction stage of the pipeline, handed to the classification stage
+ */
+struct ScanCandidates{
+	std_msgs::Header mHeader;
+	GDIFCandidates mCandidates;
+};
+typedef boost::shared_ptr<ScanCandidates> ScanCandidatesPtr;
+
+/**
+ * an additional classifier tree evaluated on the candidates of the detector of the node,
+ * see DetectorNodeParams::mConfigurations
+ */
+struct DetectorConfiguration{
+	std::string mName;
+	/// only classifies, the candidates are extracted once by the detector of the node
+	boost::shared_ptr<GDIFDetectorTree> mDetector;
+	DetectionPublishers mPublishers; ///< on <name>/Detections etc.
+};
+
+/**
+ * subscribes to the laser scans and publishes the detections
+ * all topics and parameters are relative to the given node handle
+ */
+class GDIFMultiObjectDetectorNode{
+public:
+
+	GDIFMultiObjectDetectorNode(ros::NodeHandle const& nodeHandle);
+
+	~GDIFMultiObjectDetectorNode();
+
+	void init();
+
+	/**
+	 * Only hands the scan to the extraction thread, so the spinner is never blocked by the detector.
+	 * Without the pipeline the scan is processed in the callback.
+	 */
+	void laserCallback(const sensor_msgs::LaserScan::ConstPtr& laserScan);
+
+	/**
+	 * Stores the regions of interest, they are used from the next extracted scan on.
+	 */
+	void regionsOfInterestCallback(const RegionsOfInterest::ConstPtr& regions);
+
+private:
+	/**
+	 * First stage of the pipeline: conversion, segmentation and feature extraction.
+	 */
+	void extractionLoop();
+
+	/**
+	 * Second stage of the pipeline: classification, merging and publishing.
+	 */
+	void classificationLoop();
+
+	/**
+	 * Hands the latest regions of interest to the detector before the extraction of a scan.
+	 * Without regions newer than RegionsOfInterestTimeout every scan is processed completely.
+	 */
+	void updateRegionsOfInterest(std_msgs::Header const& header);
+
+	/**
+	 * @param operatingPointDetections the detections of the additional operating points, may be empty
+	 */
+	void publishDetections(std_msgs::Header const& header, std::vector<GDIFDetection> const& detections,
+	                       std::vector<std::vector<GDIFDetection> > const& operatingPointDetections);
+
+	/**
+	 * Classifies the candidates with the tree of every configuration and publishes the detections.
+	 */
+	void classifyConfigurations(std_msgs::Header const& header, GDIFCandidates const& candidates);
+
+	/**
+	 * Publishes queue depths, dropped scans and the latency since the last call.
+	 * With GANDALF_STAGE_TIMING also the percentiles of the stage times and of the candidates per scan.
+	 */
+	void diagnosticsCallback(ros::TimerEvent const&);
+
+private:
+	ros::NodeHandle mNodeHandle;
+	DetectionPublishers mDetectionPublishers;
+	std::vector<DetectionPublishers> mOperatingPointPublishers; ///< on <name>/Detections etc.
+	ros::Publisher mPreFilterRejectionRatioTopic;
+	ros::Publisher mDiagnosticsTopic;
+	ros::Subscriber mLaserSub;
+	ros::Subscriber mRegionsOfInterestSub;
+	ros::Timer mDiagnosticsTimer;
+
+	GDIFDetectorTree mGDIFDetector;
+	std::vector<DetectorConfiguration> mConfigurations; ///< only the ones whose tree could be loaded
+	/// replaces the classifier trees of mGDIFDetector and mConfigurations, destroyed before the detectors
+	ModelReloader mModelReloader;
+	std::vector<GDIFDetection> mConfigurationDetections; ///< only used by classifyConfigurations()
+
+	DetectorNodeParams mParams;
+
+	// are there color palettes in ros?
+	std::vector<std_msgs::ColorRGBA> mColorPalette;
+
+	/// template of the published markers, without header and points
+	visualization_msgs::Marker mMarker;
+
+	bool mUsePipeline;
+	boost::scoped_ptr<Mailbox<sensor_msgs::LaserScan::ConstPtr> > mScanMailbox;
+	boost::scoped_ptr<Mailbox<ScanCandidatesPtr> > mCandidatesMailbox;
+	/// the classified ScanCandidates back to the extraction, so their buffers are reused
+	boost::scoped_ptr<Mailbox<ScanCandidatesPtr> > mFreeCandidatesMailbox;
+	GDIFCandidates mCandidates; ///< only used by laserCallback() without pipeline
+	boost::thread_group mWorkers;
+
+	boost::mutex mLatencyMutex;
+	double mLatencySum;
+	double mLatencyMax;
+	uint64_t mLatencyCount;
+	uint64_t mSkippedCandidates; ///< by the candidate budget
+	GDIFDetectorTotals mDetectorTotals; ///< of the scans since the last diagnostics
+
+	boost::mutex mRegionsOfInterestMutex;
+	std::vector<mira::laserbasedobjectdetection::RegionOfInterest> mRegionsOfInterest;
+	std::string mRegionsOfInterestFrame;
+	ros::Time mRegionsOfInterestStamp;
+	double mRegionsOfInterestTimeout; ///< [s]
+
+#ifdef GANDALF_STAGE_TIMING
+	// [ns] per scan, recorded by the stage threads, read and reset by diagnosticsCallback()
+	LatencyHistogram mConversionTime;
+	LatencyHistogram mSegmentationTime;
+	LatencyHistogram mFeatureTime;
+	LatencyHistogram mClassificationTime;
+	LatencyHistogram mPublishingTime;
+	LatencyHistogram mCandidateCount;
+#endif
+};
+
+}
+
+#endif /* GANDALF_DETECTOR_GDIFMULTIOBJECTDETECTORNODE_H_ */
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file LatencyHistogram.h
+ *    lock-free histogram for the percentiles of durations and counts
+ */
+
+#ifndef GANDALF_DETECTOR_LATENCYHISTOGRAM_H_
+#define GANDALF_DETECTOR_LATENCYHISTOGRAM_H_
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+#include <stdint.h>
+#include <sys/types.h>
+
+namespace gandalf_detector {
+
+/**
+ * Histogram of non-negative integer values, e.g. durations in [ns].
+ * Values below SubBuckets have their own bucket, every larger power of two is split into SubBuckets
+ * buckets, so the percentiles have a relative error below 1/SubBuckets. The maximum is exact.
+ *
+ * record() is lock-free and may be called by several threads, takeSnapshot() resets the histogram.
+ */
+class LatencyHistogram{
+public:
+	static const uint SubBucketBits = 3;
+	static const uint SubBuckets = 1 << SubBucketBits;
+	static const uint Buckets = (64 - SubBucketBits + 1) * SubBuckets;
+
+	struct Snapshot{
+		Snapshot() : mBuckets(Buckets, 0), mCount(0), mMax(0){}
+
+		/**
+		 * @param percentile in [0,100]
+		 * @return the upper bound of the bucket containing the percentile, at most the maximum
+		 */
+		uint64_t getPercentile(double percentile) const {
+			if(mCount == 0)
+				return 0;
+			uint64_t rank = (uint64_t)(percentile / 100.0 * (mCount - 1)) + 1;
+			uint64_t count = 0;
+			for(uint i = 0; i < Buckets; ++i){
+				count += mBuckets[i];
+				if(count >= rank)
+					return std::min(getBucketUpperBound(i), mMax);
+			}
+			return mMax;
+		}
+
+		std::vector<uint64_t> mBuckets;
+		uint64_t mCount;
+		uint64_t mMax;
+	};
+
+	LatencyHistogram() : mMax(0){
+		for(uint i = 0; i < Buckets; ++i)
+			mBuckets[i] = 0;
+	}
+
+	void record(uint64_t value){
+		mBuckets[getBucket(value)].fetch_add(1, std::memory_order_relaxed);
+		uint64_t max = mMax.load(std::memory_order_relaxed);
+		while(value > max && !mMax.compare_exchange_weak(max, value, std::memory_order_relaxed)){}
+	}
+
+	/**
+	 * @return the values recorded since the last snapshot
+	 */
+	Snapshot takeSnapshot(){
+		Snapshot snapshot;
+		for(uint i = 0; i < Buckets; ++i){
+			snapshot.mBuckets[i] = mBuckets[i].exchange(0, std::memory_order_relaxed);
+			snapshot.mCount += snapshot.mBuckets[i];
+		}
+		snapshot.mMax = mMax.exchange(0, std::memory_order_relaxed);
+		return snapshot;
+	}
+
+	static uint getBucket(uint64_t value){
+		if(value < SubBuckets)
+			return value;
+		uint exponent = 63 - __builtin_clzll(value);
+		uint subBucket = (value >> (exponent - SubBucketBits)) & (SubBuckets - 1);
+		return (exponent - SubBucketBits + 1) * SubBuckets + subBucket;
+	}
+
+	static uint64_t getBucketUpperBound(uint bucket){
+		if(bucket < SubBuckets)
+			return bucket;
+		uint exponent = bucket / SubBuckets + SubBucketBits - 1;
+		uint64_t width = (uint64_t)1 << (exponent - SubBucketBits);
+		return ((uint64_t)(SubBuckets + bucket % SubBuckets) << (exponent - SubBucketBits)) + width - 1;
+	}
+
+private:
+	std::atomic<uint64_t> mBuckets[Buckets];
+	std::atomic<uint64_t> mMax;
+};
+
+}
+
+#endif /* GANDALF_DETECTOR_LATENCYHISTOGRAM_H_ */
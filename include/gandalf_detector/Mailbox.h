@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file Mailbox.h
+ *    header File for the mailbox between the stages of the detector pipeline
+ */
+
+#ifndef GANDALF_DETECTOR_MAILBOX_H_
+#define GANDALF_DETECTOR_MAILBOX_H_
+
+#include <atomic>
+#include <deque>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/locks.hpp>
+#include <boost/thread/condition_variable.hpp>
+
+namespace gandalf_detector {
+
+enum MailboxPolicy{
+	KEEP_LATEST=0, ///< a single slot, a new element replaces the waiting one (lock-free)
+	DROP_OLDEST=1  ///< a queue of bounded depth, the oldest element is dropped if the queue is full
+};
+
+/**
+ * hands elements (e.g. scans) from one thread to another without ever blocking the producer for longer
+ * than a notification, if the consumer is too slow elements are dropped according to the policy
+ */
+template<typename T>
+class Mailbox{
+public:
+	/**
+	 * @param depth maximal number of waiting elements of DROP_OLDEST, KEEP_LATEST ignores it and always keeps one
+	 */
+	Mailbox(MailboxPolicy policy=KEEP_LATEST,uint depth=1) :
+		mPolicy(policy), mDepth(depth>0 ? depth : 1), mSlot(NULL), mQueueSize(0), mDropped(0), mClosed(false){}
+
+	~Mailbox(){
+		delete mSlot.exchange(NULL);
+	}
+
+	/**
+	 * @return false if an older element was dropped for the new one
+	 */
+	bool post(T const& item){
+		bool dropped=false;
+		if(mPolicy==KEEP_LATEST){
+			Holder* previous=mSlot.exchange(new Holder(item));
+			if(previous!=NULL){
+				delete previous;
+				dropped=true;
+			}
+		}
+		else{
+			boost::lock_guard<boost::mutex> lock(mMutex);
+			if(mQueue.size()>=mDepth){
+				mQueue.pop_front();
+				dropped=true;
+			}
+			mQueue.push_back(item);
+			mQueueSize=mQueue.size();
+		}
+		if(dropped)mDropped++;
+		notify();
+		return !dropped;
+	}
+
+	/**
+	 * takes the next element without waiting
+	 * @return false if the mailbox is empty
+	 */
+	bool tryTake(T & oItem){
+		if(mPolicy==KEEP_LATEST){
+			Holder* holder=mSlot.exchange(NULL);
+			if(holder==NULL)return false;
+			oItem=holder->mItem;
+			delete holder;
+			return true;
+		}
+		boost::lock_guard<boost::mutex> lock(mMutex);
+		if(mQueue.empty())return false;
+		oItem=mQueue.front();
+		mQueue.pop_front();
+		mQueueSize=mQueue.size();
+		return true;
+	}
+
+	/**
+	 * waits for the next element
+	 * @return false if the mailbox was closed
+	 */
+	bool wait(T & oItem){
+		while(true){
+			if(tryTake(oItem))return true;
+			boost::unique_lock<boost::mutex> lock(mMutex);
+			while(!mClosed&&getQueueDepth()==0){
+				mCondition.wait(lock);
+			}
+			if(mClosed)return false;
+		}
+	}
+
+	/**
+	 * wakes up all waiting consumers, wait() returns false from now on
+	 */
+	void close(){
+		{
+			boost::lock_guard<boost::mutex> lock(mMutex);
+			mClosed=true;
+		}
+		mCondition.notify_all();
+	}
+
+	/**
+	 * @return number of waiting elements
+	 */
+	uint getQueueDepth() const {
+		if(mPolicy==KEEP_LATEST)return mSlot.load()!=NULL ? 1 : 0;
+		return mQueueSize.load();
+	}
+
+	/**
+	 * @return number of elements dropped since the creation of the mailbox
+	 */
+	uint64_t getDropped() const {return mDropped.load();}
+
+private:
+	struct Holder{
+		Holder(T const& item) : mItem(item){}
+		T mItem;
+	};
+
+	void notify(){
+		// the consumer checks for new elements while holding the mutex, so a short lock prevents lost wake ups
+		{
+			boost::lock_guard<boost::mutex> lock(mMutex);
+		}
+		mCondition.notify_one();
+	}
+
+	MailboxPolicy mPolicy;
+	uint mDepth;
+	std::atomic<Holder*> mSlot;
+	std::deque<T> mQueue;
+	std::atomic<uint> mQueueSize; ///< size of mQueue, readable without the mutex
+	std::atomic<uint64_t> mDropped;
+	bool mClosed;
+	boost::mutex mMutex;
+	boost::condition_variable mCondition;
+};
+
+}
+
+#endif /* GANDALF_DETECTOR_MAILBOX_H_ */
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file ModelReloader.h
+ *    replaces the classifier tree of running detectors without restarting the node
+ */
+
+#ifndef GANDALF_DETECTOR_MODELRELOADER_H_
+#define GANDALF_DETECTOR_MODELRELOADER_H_
+
+#include <ros/ros.h>
+#include <ros/callback_queue.h>
+#include <std_srvs/Trigger.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <sstream>
+
+#include <boost/function.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <gandalf_detector/DetectorNodeParams.h>
+
+namespace gandalf_detector {
+
+/**
+ * Offers the service ReloadModel (std_srvs/Trigger). A call re-reads the classifier tree (ClassifierFiles,
+ * Thresholds, the operating points, ...) from the parameters of the node handle and loads it. The service
+ * has its own callback queue and thread, so the detection continues with the old tree meanwhile and the
+ * call returns once the tree is loaded. The loaded tree is handed to the swap function, which replaces it
+ * atomically in the detectors (GDIFDetectorTree::setClassifier()).
+ * If the new tree cannot be loaded, the old one is kept and the call fails with the reason as message.
+ * The trees of the configurations added with addConfiguration() are reloaded with the default tree, all
+ * trees are replaced only if all of them could be loaded. The other parameters are not reloaded. Model
+ * files which did not change since the last load are not loaded again, so the trees used at the start
+ * are loaded by loadClassifier() and addConfiguration().
+ */
+class ModelReloader{
+public:
+	typedef boost::function<void (boost::shared_ptr<AdaboostClassifierNode const>)> SwapFunction;
+
+	ModelReloader() : mLoading(false), mReloads(0), mFailedReloads(0), mLoadTime(0.0){}
+
+	~ModelReloader(){
+		// waits for a running reload, the detectors of the swap function are destroyed after the reloader
+		if(mSpinner)
+			mSpinner->stop();
+	}
+
+	void advertise(ros::NodeHandle const& nodeHandle, SwapFunction const& swap){
+		mNodeHandle = nodeHandle;
+		mSwap = swap;
+		ros::NodeHandle tServiceHandle(nodeHandle);
+		tServiceHandle.setCallbackQueue(&mCallbackQueue);
+		mService = tServiceHandle.advertiseService("ReloadModel", &ModelReloader::reloadCallback, this);
+		mSpinner.reset(new ros::AsyncSpinner(1, &mCallbackQueue));
+		mSpinner->start();
+	}
+
+	/**
+	 * the first load of the default tree, with the registry of the reloads, so the first reload only loads changed files
+	 * @return an empty pointer if the tree could not be loaded
+	 */
+	boost::shared_ptr<AdaboostClassifierNode const> loadClassifier(DetectorNodeParams const& params){
+		return loadWithRegistry(params, mRegistry);
+	}
+
+	/**
+	 * loads the tree of the configuration (see DetectorNodeParams::getConfigurationParams()) with its own registry,
+	 * if it could be loaded, it is reloaded with the default tree, has to be called before advertise()
+	 * @return an empty pointer if the tree could not be loaded, the configuration is not added then
+	 */
+	boost::shared_ptr<AdaboostClassifierNode const> addConfiguration(std::string const& name, DetectorNodeParams const& params,
+	                                                                 SwapFunction const& swap){
+		boost::shared_ptr<AdaboostModelRegistry> tRegistry(new AdaboostModelRegistry());
+		boost::shared_ptr<AdaboostClassifierNode const> tClassifier = loadWithRegistry(params, *tRegistry);
+		if(!tClassifier)
+			return tClassifier;
+		mConfigurations.push_back(name);
+		mConfigurationSwaps.push_back(swap);
+		mConfigurationRegistries.push_back(tRegistry);
+		return tClassifier;
+	}
+
+	/**
+	 * loads the model and swaps it into the detectors, returns after the model was loaded
+	 * @param oMessage the result, the reason if the model was not replaced
+	 * @return false if a model is already being loaded or the model could not be loaded
+	 */
+	bool reload(std::string& oMessage){
+		if(mLoading.exchange(true)){
+			oMessage = "the model is already being reloaded";
+			ROS_WARN("%s", oMessage.c_str());
+			return false;
+		}
+		LoadingGuard tGuard(mLoading);
+		return load(oMessage);
+	}
+
+	uint64_t getReloads() const {return mReloads;}
+	uint64_t getFailedReloads() const {return mFailedReloads;}
+	/// [s] of the last successful reload
+	double getLoadTime() const {return mLoadTime;}
+
+private:
+	/**
+	 * resets the loading flag when the reload ends, also by an exception
+	 */
+	class LoadingGuard{
+	public:
+		explicit LoadingGuard(std::atomic<bool>& loading) : mLoading(loading){}
+		~LoadingGuard(){mLoading = false;}
+	private:
+		std::atomic<bool>& mLoading;
+	};
+
+	static boost::shared_ptr<AdaboostClassifierNode const> loadWithRegistry(DetectorNodeParams const& params, AdaboostModelRegistry& ioRegistry){
+		try{
+			return gandalf_detector::loadClassifier(params, ioRegistry);
+		}
+		catch(std::exception const& e){
+			ROS_ERROR("could not load the classifier tree: %s", e.what());
+			return boost::shared_ptr<AdaboostClassifierNode const>();
+		}
+	}
+
+	bool reloadCallback(std_srvs::Trigger::Request&, std_srvs::Trigger::Response& response){
+		response.success = reload(response.message);
+		return true;
+	}
+
+	/**
+	 * a corrupt model file throws while it is loaded (e.g. cv::Exception), the reload fails like for a missing file
+	 */
+	bool load(std::string& oMessage){
+		try{
+			return loadTrees(oMessage);
+		}
+		catch(std::exception const& e){
+			mFailedReloads++;
+			oMessage = std::string("could not load the classifier tree, the old one is kept: ") + e.what();
+			ROS_ERROR("%s", oMessage.c_str());
+			return false;
+		}
+	}
+
+	bool loadTrees(std::string& oMessage){
+		std::chrono::steady_clock::time_point tStart = std::chrono::steady_clock::now();
+		DetectorNodeParams tParams;
+		readDetectorNodeParams(mNodeHandle, tParams);
+		boost::shared_ptr<AdaboostClassifierNode const> tClassifier = gandalf_detector::loadClassifier(tParams, mRegistry);
+		if(!tClassifier){
+			mFailedReloads++;
+			oMessage = "could not load the classifier tree, the old one is kept";
+			ROS_ERROR("%s", oMessage.c_str());
+			return false;
+		}
+		std::vector<boost::shared_ptr<AdaboostClassifierNode const> > tConfigurationClassifiers;
+		for(uint k = 0; k < mConfigurations.size(); ++k){
+			std::vector<std::string>::const_iterator tName = std::find(tParams.mConfigurations.begin(), tParams.mConfigurations.end(), mConfigurations[k]);
+			boost::shared_ptr<AdaboostClassifierNode const> tConfigurationClassifier;
+			if(tName != tParams.mConfigurations.end())
+				tConfigurationClassifier = gandalf_detector::loadClassifier(tParams.getConfigurationParams(tName - tParams.mConfigurations.begin()), *mConfigurationRegistries[k]);
+			if(!tConfigurationClassifier){
+				mFailedReloads++;
+				oMessage = "could not load the classifier tree of configuration " + mConfigurations[k] + ", the old trees are kept";
+				ROS_ERROR("%s", oMessage.c_str());
+				return false;
+			}
+			tConfigurationClassifiers.push_back(tConfigurationClassifier);
+		}
+		mSwap(tClassifier);
+		for(uint k = 0; k < mConfigurations.size(); ++k)
+			mConfigurationSwaps[k](tConfigurationClassifiers[k]);
+		mLoadTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - tStart).count();
+		mReloads++;
+		std::ostringstream tMessage;
+		tMessage << "reloaded the model with " << tParams.mClassifierParams.size() << " classifiers in " << mLoadTime << " s";
+		oMessage = tMessage.str();
+		ROS_INFO("%s", oMessage.c_str());
+		return true;
+	}
+
+private:
+	ros::NodeHandle mNodeHandle;
+	ros::CallbackQueue mCallbackQueue; ///< only of the service, destroyed after it
+	ros::ServiceServer mService;
+	boost::scoped_ptr<ros::AsyncSpinner> mSpinner;
+	SwapFunction mSwap;
+	AdaboostModelRegistry mRegistry; ///< only used by load()
+	std::vector<std::string> mConfigurations;
+	std::vector<SwapFunction> mConfigurationSwaps;
+	std::vector<boost::shared_ptr<AdaboostModelRegistry> > mConfigurationRegistries; ///< only used by load()
+	std::atomic<bool> mLoading;
+	std::atomic<uint64_t> mReloads;
+	std::atomic<uint64_t> mFailedReloads;
+	std::atomic<double> mLoadTime;
+};
+
+}
+
+#endif /* GANDALF_DETECTOR_MODELRELOADER_H_ */
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file ScanConversion.h
+ *    conversion of ROS laser scans to mira range scans
+ */
+
+#ifndef GANDALF_DETECTOR_SCANCONVERSION_H_
+#define GANDALF_DETECTOR_SCANCONVERSION_H_
+
+#include <cmath>
+#include <sensor_msgs/LaserScan.h>
+#include <robot/RangeScan.h>
+#include <RangeScanView.h>
+
+namespace gandalf_detector {
+
+using mira::robot::RangeScan;
+using mira::laserbasedobjectdetection::RangeScanView;
+
+/**
+ * The view of the ranges of a ROS laser scan, the detector works on them in place without any copy.
+ * The range codes are derived from range_min and range_max like getRangeCode() does.
+ * The scan has to stay alive as long as the view is used.
+ */
+inline RangeScanView getScanView(sensor_msgs::LaserScan const& laserScan){
+	return RangeScanView(laserScan.ranges.empty() ? NULL : &laserScan.ranges[0], laserScan.ranges.size(),
+			laserScan.angle_min, laserScan.angle_increment, laserScan.range_min, laserScan.range_max);
+}
+
+/**
+ * Maps a ROS range reading to a mira range code (see REP 117).
+ * NaN is an erroneous reading, -Inf and readings below range_min are too close,
+ * +Inf and readings above range_max are out of range.
+ */
+inline uint16 getRangeCode(float range, float rangeMin, float rangeMax){
+	if(std::isnan(range))
+		return RangeScan::Invalid;
+	if(range < rangeMin)
+		return RangeScan::BelowMinimum;
+	if(range > rangeMax)
+		return RangeScan::AboveMaximum;
+	return RangeScan::Valid;
+}
+
+/**
+ * Converts the ROS range scan to the mira range scan.
+ * Only needed if a RangeScan is required, the detector itself takes getScanView().
+ */
+inline void convertScan(sensor_msgs::LaserScan const& laserScan, RangeScan& rangeScan){
+	// header
+	rangeScan.startAngle = laserScan.angle_min;
+	rangeScan.deltaAngle = laserScan.angle_increment;
+	// this is a hack
+	rangeScan.coneAngle = laserScan.angle_increment;
+	/// The aperture of the sensor in [m].
+	rangeScan.aperture = 0.0;
+	/// The measuring error of the sensor that delivered this scan.
+	rangeScan.stdError = 0.0;
+	/// The minimum range of valid measurements
+	/// (measurements below this value result in BelowMinimum range code).
+	rangeScan.minimumRange = laserScan.range_min;
+	/// The maximum range of valid measurements
+	/// (measurements above this value result in AboveMaximum range code).
+	rangeScan.maximumRange = laserScan.range_max;
+
+	// data
+	rangeScan.range = laserScan.ranges;
+	rangeScan.valid.resize(rangeScan.range.size());
+	for(uint i = 0; i < rangeScan.range.size(); ++i){
+		rangeScan.valid[i] = getRangeCode(rangeScan.range[i], laserScan.range_min, laserScan.range_max);
+	}
+	rangeScan.certainty.clear();
+	rangeScan.reflectance = laserScan.intensities;
+}
+
+}
+
+#endif /* GANDALF_DETECTOR_SCANCONVERSION_H_ */
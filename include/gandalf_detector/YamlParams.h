@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file YamlParams.h
+ *    parameters from a YAML file for running the detector without ROS master
+ */
+
+#ifndef GANDALF_DETECTOR_YAMLPARAMS_H_
+#define GANDALF_DETECTOR_YAMLPARAMS_H_
+
+#include <string>
+
+#include <ros/console.h>
+
+#include <yaml-cpp/yaml.h>
+
+namespace gandalf_detector {
+
+/**
+ * provides the parameters of a rosparam YAML file (e.g. launch/stub_parameter.yaml)
+ * with the same interface as ros::NodeHandle, so readDetectorNodeParams() can read them
+ */
+class YamlParams{
+public:
+	/**
+	 * @throw YAML::Exception if the file can not be loaded
+	 */
+	explicit YamlParams(std::string const& fileName)
+		: mParams(YAML::LoadFile(fileName)){
+	}
+
+	/**
+	 * sets or replaces a parameter, the value is parsed as YAML (e.g. "0.1" or "[0, 1]")
+	 * @throw YAML::Exception if the value can not be parsed
+	 */
+	void setParam(std::string const& name, std::string const& value){
+		mParams[name] = YAML::Load(value);
+	}
+
+	bool hasParam(std::string const& name) const {
+		YAML::Node tValue;
+		return findParam(mParams, name, tValue);
+	}
+
+	template<typename T>
+	bool getParam(std::string const& name, T& oValue) const {
+		YAML::Node tValue;
+		if(!findParam(mParams, name, tValue))
+			return false;
+		try{
+			oValue = tValue.template as<T>();
+		}
+		catch(YAML::Exception const& e){
+			ROS_ERROR("could not read param [%s]: %s", name.c_str(), e.what());
+			return false;
+		}
+		return true;
+	}
+
+	template<typename T>
+	bool param(std::string const& name, T& oValue, T const& defaultValue) const {
+		if(getParam(name, oValue))
+			return true;
+		oValue = defaultValue;
+		return false;
+	}
+
+private:
+	/**
+	 * a name with '/' is looked up in the nested maps like a namespace of the parameter server
+	 * (e.g. Walkers/Thresholds), a key containing the '/' itself (e.g. from setParam()) is found first
+	 */
+	static bool findParam(YAML::Node const& node, std::string const& name, YAML::Node& oValue){
+		if(!node || !node.IsMap())
+			return false;
+		if(node[name]){
+			oValue.reset(node[name]);
+			return true;
+		}
+		std::size_t tSeparator = name.find('/');
+		if(tSeparator == std::string::npos)
+			return false;
+		return findParam(node[name.substr(0, tSeparator)], name.substr(tSeparator + 1), oValue);
+	}
+
+private:
+	YAML::Node mParams;
+};
+
+}
+
+#endif /* GANDALF_DETECTOR_YAMLPARAMS_H_ */
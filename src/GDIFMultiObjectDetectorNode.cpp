@@ -0,0 +1,352 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+#include <gandalf_detector/GDIFMultiObjectDetectorNode.h>
+
+#include <std_msgs/Float32.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
+
+#include <gandalf_detector/ScanConversion.h>
+#include <gandalf_detector/Diagnostics.h>
+
+namespace gandalf_detector {
+
+///////////////////////////////////////////////////////////////////////////////
+
+GDIFMultiObjectDetectorNode::GDIFMultiObjectDetectorNode(ros::NodeHandle const& nodeHandle) : mNodeHandle(nodeHandle){
+	mColorPalette = getLabelColorPalette();
+	mMarker = getDetectionMarker();
+
+	mUsePipeline = false;
+	mLatencySum = 0.0;
+	mLatencyMax = 0.0;
+	mLatencyCount = 0;
+	mSkippedCandidates = 0;
+	mRegionsOfInterestTimeout = 1.0;
+}
+
+GDIFMultiObjectDetectorNode::~GDIFMultiObjectDetectorNode(){
+	// the callbacks have to be gone before the mailboxes are closed and the members are destroyed
+	mDiagnosticsTimer.stop();
+	mRegionsOfInterestSub.shutdown();
+	mLaserSub.shutdown();
+	if(mScanMailbox)
+		mScanMailbox->close();
+	if(mCandidatesMailbox)
+		mCandidatesMailbox->close();
+	if(mFreeCandidatesMailbox)
+		mFreeCandidatesMailbox->close();
+	mWorkers.join_all();
+}
+
+void GDIFMultiObjectDetectorNode::init(){
+	mDetectionPublishers.advertise(mNodeHandle);
+
+	int tInt;
+	double tDouble;
+
+	readDetectorNodeParams(mNodeHandle, mParams);
+	if(mParams.mPreFilterParams.mEnabled){
+		mPreFilterRejectionRatioTopic = mNodeHandle.advertise<std_msgs::Float32>("PreFilterRejectionRatio", 10);
+	}
+	// loaded by the reloader, so a reload only loads the changed model files
+	boost::shared_ptr<AdaboostClassifierNode const> tClassifier = mModelReloader.loadClassifier(mParams);
+	if(!tClassifier){
+		ROS_ERROR("could not load the classifier tree, no candidates are classified until ReloadModel succeeds");
+	}
+	initializeDetector(mGDIFDetector, mParams, tClassifier);
+	mOperatingPointPublishers.resize(mParams.mOperatingPoints.size());
+	for(uint k = 0; k < mParams.mOperatingPoints.size(); ++k){
+		mOperatingPointPublishers[k].advertise(mNodeHandle, mParams.mOperatingPoints[k] + "/");
+	}
+	for(uint k = 0; k < mParams.mConfigurations.size(); ++k){
+		DetectorNodeParams tParams = mParams.getConfigurationParams(k);
+		DetectorConfiguration tConfiguration;
+		tConfiguration.mName = mParams.mConfigurations[k];
+		tConfiguration.mDetector.reset(new GDIFDetectorTree());
+		boost::shared_ptr<AdaboostClassifierNode const> tConfigurationClassifier = mModelReloader.addConfiguration(tConfiguration.mName,
+				tParams, boost::bind(&GDIFDetectorTree::setClassifier, tConfiguration.mDetector.get(), _1));
+		if(!tConfigurationClassifier){
+			ROS_ERROR("could not load the classifier tree of configuration [%s], the configuration is disabled", mParams.mConfigurations[k].c_str());
+			continue;
+		}
+		initializeDetector(*tConfiguration.mDetector, tParams, tConfigurationClassifier);
+		tConfiguration.mPublishers.advertise(mNodeHandle, tConfiguration.mName + "/");
+		mConfigurations.push_back(tConfiguration);
+	}
+	mModelReloader.advertise(mNodeHandle, boost::bind(&GDIFDetectorTree::setClassifier, &mGDIFDetector, _1));
+
+	// the extraction of the next scan runs concurrently to the classification of the previous one,
+	// if the detector is too slow, old scans are dropped instead of queued
+	mNodeHandle.param("UsePipeline", mUsePipeline, true);
+	mNodeHandle.param("ScanQueuePolicy", tInt, (int)KEEP_LATEST);
+	MailboxPolicy tPolicy = (MailboxPolicy)tInt;
+	mNodeHandle.param("ScanQueueDepth", tInt, 1);
+	if(tInt < 1){
+		ROS_ERROR("ScanQueueDepth [%d] < 1", tInt);
+		tInt = 1;
+	}
+	if(tPolicy == KEEP_LATEST && tInt > 1){
+		// a single slot, only DROP_OLDEST queues more than one scan
+		ROS_WARN("ScanQueueDepth [%d] is ignored with ScanQueuePolicy 0, only the latest scan is kept", tInt);
+		tInt = 1;
+	}
+	if(mUsePipeline){
+		mScanMailbox.reset(new Mailbox<sensor_msgs::LaserScan::ConstPtr>(tPolicy, tInt));
+		mCandidatesMailbox.reset(new Mailbox<ScanCandidatesPtr>(tPolicy, tInt));
+		// one in each stage and the queued ones, more are freed
+		mFreeCandidatesMailbox.reset(new Mailbox<ScanCandidatesPtr>(DROP_OLDEST, tInt + 2));
+		mWorkers.create_thread(boost::bind(&GDIFMultiObjectDetectorNode::extractionLoop, this));
+		mWorkers.create_thread(boost::bind(&GDIFMultiObjectDetectorNode::classificationLoop, this));
+	}
+	mDiagnosticsTopic = mNodeHandle.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 10);
+	mNodeHandle.param("DiagnosticsPeriod", tDouble, 1.0);
+	mDiagnosticsTimer = mNodeHandle.createTimer(ros::Duration(tDouble), &GDIFMultiObjectDetectorNode::diagnosticsCallback, this);
+
+	if(mParams.mRegionOfInterestParams.mEnabled){
+		mNodeHandle.param("RegionsOfInterestTimeout", mRegionsOfInterestTimeout, 1.0);
+		mRegionsOfInterestSub = mNodeHandle.subscribe<RegionsOfInterest>("RegionsOfInterest", 10, &GDIFMultiObjectDetectorNode::regionsOfInterestCallback, this);
+	}
+
+	// subscribe as last step, the callback needs the mailboxes
+	mLaserSub = mNodeHandle.subscribe<sensor_msgs::LaserScan>("laser", 1000, &GDIFMultiObjectDetectorNode::laserCallback, this);
+}
+
+void GDIFMultiObjectDetectorNode::laserCallback(const sensor_msgs::LaserScan::ConstPtr& laserScan){
+	if(mUsePipeline){
+		mScanMailbox->post(laserScan);
+		return;
+	}
+	GANDALF_STAGE_START(conversionStart);
+	RangeScanView scan = getScanView(*laserScan);
+#ifdef GANDALF_STAGE_TIMING
+	mConversionTime.record(getStageTimestamp() - conversionStart);
+#endif
+	updateRegionsOfInterest(laserScan->header);
+	mGDIFDetector.extractCandidates(scan, mCandidates);
+	std::vector<GDIFDetection> detections;
+	std::vector<std::vector<GDIFDetection> > operatingPointDetections;
+	if(mOperatingPointPublishers.empty())
+		mGDIFDetector.classifyCandidates(mCandidates, detections);
+	else
+		mGDIFDetector.classifyCandidates(mCandidates, detections, operatingPointDetections);
+	publishDetections(laserScan->header, detections, operatingPointDetections);
+	classifyConfigurations(laserScan->header, mCandidates);
+}
+
+void GDIFMultiObjectDetectorNode::regionsOfInterestCallback(const RegionsOfInterest::ConstPtr& regions){
+	boost::lock_guard<boost::mutex> lock(mRegionsOfInterestMutex);
+	mRegionsOfInterest.clear();
+	for(uint i = 0; i < regions->regions.size(); ++i){
+		RegionOfInterest const& region = regions->regions[i];
+		if(region.type == RegionOfInterest::SECTOR)
+			mRegionsOfInterest.push_back(mira::laserbasedobjectdetection::RegionOfInterest::sector(region.min_angle, region.max_angle));
+		else
+			mRegionsOfInterest.push_back(mira::laserbasedobjectdetection::RegionOfInterest::circle(Point2f(region.center_x, region.center_y), region.radius));
+	}
+	mRegionsOfInterestFrame = regions->header.frame_id;
+	mRegionsOfInterestStamp = regions->header.stamp.isZero() ? ros::Time::now() : regions->header.stamp;
+}
+
+void GDIFMultiObjectDetectorNode::updateRegionsOfInterest(std_msgs::Header const& header){
+	if(!mParams.mRegionOfInterestParams.mEnabled)
+		return;
+	boost::lock_guard<boost::mutex> lock(mRegionsOfInterestMutex);
+	if(mRegionsOfInterestStamp.isZero() || (header.stamp - mRegionsOfInterestStamp).toSec() > mRegionsOfInterestTimeout){
+		mGDIFDetector.clearRegionsOfInterest();
+		return;
+	}
+	if(!mRegionsOfInterestFrame.empty() && mRegionsOfInterestFrame != header.frame_id){
+		ROS_WARN_THROTTLE(10.0, "regions of interest in frame [%s] instead of the frame of the scans [%s] are ignored",
+				mRegionsOfInterestFrame.c_str(), header.frame_id.c_str());
+		mGDIFDetector.clearRegionsOfInterest();
+		return;
+	}
+	mGDIFDetector.setRegionsOfInterest(mRegionsOfInterest);
+}
+
+void GDIFMultiObjectDetectorNode::extractionLoop(){
+	sensor_msgs::LaserScan::ConstPtr laserScan;
+	ScanCandidatesPtr candidates;
+	while(mScanMailbox->wait(laserScan)){
+		// the detector works directly on the ranges of the message
+		GANDALF_STAGE_START(conversionStart);
+		// a classified one is reused, a new one is only needed while the pipeline fills
+		if(!mFreeCandidatesMailbox->tryTake(candidates))
+			candidates.reset(new ScanCandidates());
+		candidates->mHeader = laserScan->header;
+		RangeScanView scan = getScanView(*laserScan);
+#ifdef GANDALF_STAGE_TIMING
+		mConversionTime.record(getStageTimestamp() - conversionStart);
+#endif
+		updateRegionsOfInterest(laserScan->header);
+		mGDIFDetector.extractCandidates(scan, candidates->mCandidates);
+		mCandidatesMailbox->post(candidates);
+		candidates.reset();
+	}
+}
+
+void GDIFMultiObjectDetectorNode::classificationLoop(){
+	ScanCandidatesPtr candidates;
+	std::vector<GDIFDetection> detections;
+	std::vector<std::vector<GDIFDetection> > operatingPointDetections;
+	while(mCandidatesMailbox->wait(candidates)){
+		detections.clear();
+		if(mOperatingPointPublishers.empty()){
+			mGDIFDetector.classifyCandidates(candidates->mCandidates, detections);
+		}
+		else{
+			for(uint k = 0; k < operatingPointDetections.size(); ++k)
+				operatingPointDetections[k].clear();
+			mGDIFDetector.classifyCandidates(candidates->mCandidates, detections, operatingPointDetections);
+		}
+		publishDetections(candidates->mHeader, detections, operatingPointDetections);
+		classifyConfigurations(candidates->mHeader, candidates->mCandidates);
+		mFreeCandidatesMailbox->post(candidates);
+		candidates.reset();
+	}
+}
+
+void GDIFMultiObjectDetectorNode::publishDetections(std_msgs::Header const& header, std::vector<GDIFDetection> const& detections,
+                                                    std::vector<std::vector<GDIFDetection> > const& operatingPointDetections){
+	GDIFDetectorStatistics const& statistics = mGDIFDetector.getStatistics();
+	ROS_DEBUG_NAMED("statistics", "scan [%d]: [%d] segments, [%d] too small, [%d] removed due to invalid beams, [%d] candidates, [%d] out of range, "
+			"[%d] on the background, [%d] skipped, [%d] outside of the regions of interest, [%d] invalid boxes, [%d] classified",
+			header.seq, statistics.mSegments, statistics.mSmallSegments, statistics.mInvalidBeamSegments, statistics.mCandidates, statistics.mOutOfRange,
+			statistics.mBackgroundRejected, statistics.mSkippedCandidates, statistics.mOutsideRegionsOfInterest, statistics.mInvalidBoxes, statistics.mClassified);
+	if(mParams.mPreFilterParams.mEnabled && mPreFilterRejectionRatioTopic.getNumSubscribers() > 0){
+		std_msgs::Float32Ptr rejectionRatio(new std_msgs::Float32());
+		rejectionRatio->data = statistics.getPreFilterRejectionRatio();
+		mPreFilterRejectionRatioTopic.publish(rejectionRatio);
+	}
+
+	GANDALF_STAGE_START(publishingStart);
+	mDetectionPublishers.publish(header, detections, mColorPalette, mMarker);
+	for(uint k = 0; k < operatingPointDetections.size() && k < mOperatingPointPublishers.size(); ++k)
+		mOperatingPointPublishers[k].publish(header, operatingPointDetections[k], mColorPalette, mMarker);
+#ifdef GANDALF_STAGE_TIMING
+	mPublishingTime.record(getStageTimestamp() - publishingStart);
+	mSegmentationTime.record(statistics.mSegmentationTime);
+	mFeatureTime.record(statistics.mFeatureTime);
+	mClassificationTime.record(statistics.mClassificationTime);
+	mCandidateCount.record(statistics.mCandidates);
+#endif
+
+	// latency from the acquisition of the scan to the publishing of its detections
+	double latency = (ros::Time::now() - header.stamp).toSec();
+	boost::lock_guard<boost::mutex> lock(mLatencyMutex);
+	mLatencySum += latency;
+	mLatencyMax = std::max(mLatencyMax, latency);
+	mLatencyCount++;
+	mSkippedCandidates += statistics.mSkippedCandidates;
+	mDetectorTotals.add(statistics);
+}
+
+void GDIFMultiObjectDetectorNode::classifyConfigurations(std_msgs::Header const& header, GDIFCandidates const& candidates){
+	for(uint k = 0; k < mConfigurations.size(); ++k){
+		mConfigurationDetections.clear();
+		mConfigurations[k].mDetector->classifyCandidates(candidates, mConfigurationDetections);
+		mConfigurations[k].mPublishers.publish(header, mConfigurationDetections, mColorPalette, mMarker);
+	}
+}
+
+void GDIFMultiObjectDetectorNode::diagnosticsCallback(ros::TimerEvent const&){
+	diagnostic_msgs::DiagnosticStatus status;
+	status.level = diagnostic_msgs::DiagnosticStatus::OK;
+	status.name = mNodeHandle.getNamespace() + ": pipeline";
+	status.hardware_id = "none";
+	status.message = mUsePipeline ? "pipelined" : "inline";
+	if(mUsePipeline){
+		status.values.push_back(makeKeyValue("scan queue depth", mScanMailbox->getQueueDepth()));
+		status.values.push_back(makeKeyValue("dropped scans", mScanMailbox->getDropped()));
+		status.values.push_back(makeKeyValue("candidates queue depth", mCandidatesMailbox->getQueueDepth()));
+		status.values.push_back(makeKeyValue("dropped candidates", mCandidatesMailbox->getDropped()));
+	}
+	{
+		boost::lock_guard<boost::mutex> lock(mLatencyMutex);
+		status.values.push_back(makeKeyValue("processed scans", mLatencyCount));
+		status.values.push_back(makeKeyValue("mean latency [s]", mLatencyCount > 0 ? mLatencySum / mLatencyCount : 0.0));
+		status.values.push_back(makeKeyValue("max latency [s]", mLatencyMax));
+		if(mParams.mCandidateBudgetParams.mEnabled)
+			status.values.push_back(makeKeyValue("skipped candidates", mSkippedCandidates));
+		status.values.push_back(makeKeyValue("model reloads", mModelReloader.getReloads()));
+		status.values.push_back(makeKeyValue("failed model reloads", mModelReloader.getFailedReloads()));
+		status.values.push_back(makeKeyValue("model load time [s]", mModelReloader.getLoadTime()));
+		boost::shared_ptr<AdaboostClassifierNode const> classifier = mGDIFDetector.getClassifier();
+		status.values.push_back(makeKeyValue("model bytes", classifier ? classifier->getModelBytes() : 0));
+		mLatencySum = 0.0;
+		mLatencyMax = 0.0;
+		mLatencyCount = 0;
+		mSkippedCandidates = 0;
+	}
+	diagnostic_msgs::DiagnosticStatus funnel;
+	funnel.level = diagnostic_msgs::DiagnosticStatus::OK;
+	funnel.name = mNodeHandle.getNamespace() + ": candidates";
+	funnel.hardware_id = "none";
+	funnel.message = "per scan";
+	{
+		boost::lock_guard<boost::mutex> lock(mLatencyMutex);
+		addDetectorTotals(funnel, mDetectorTotals);
+		mDetectorTotals.reset();
+	}
+	diagnostic_msgs::DiagnosticArray diagnostics;
+	diagnostics.header.stamp = ros::Time::now();
+	diagnostics.status.push_back(status);
+	diagnostics.status.push_back(funnel);
+#ifdef GANDALF_STAGE_TIMING
+	diagnostic_msgs::DiagnosticStatus stages;
+	stages.level = diagnostic_msgs::DiagnosticStatus::OK;
+	stages.name = mNodeHandle.getNamespace() + ": stages";
+	stages.hardware_id = "none";
+	stages.message = "times per scan";
+	addPercentiles(stages, "conversion [us]", mConversionTime.takeSnapshot(), 1e-3);
+	addPercentiles(stages, "segmentation [us]", mSegmentationTime.takeSnapshot(), 1e-3);
+	addPercentiles(stages, "features [us]", mFeatureTime.takeSnapshot(), 1e-3);
+	addPercentiles(stages, "classification [us]", mClassificationTime.takeSnapshot(), 1e-3);
+	addPercentiles(stages, "publishing [us]", mPublishingTime.takeSnapshot(), 1e-3);
+	addPercentiles(stages, "candidates", mCandidateCount.takeSnapshot(), 1.0);
+	diagnostics.status.push_back(stages);
+#endif
+	mDiagnosticsTopic.publish(diagnostics);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
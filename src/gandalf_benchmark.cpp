@@ -0,0 +1,470 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file gandalf_benchmark.cpp
+ *    micro and end-to-end benchmarks of the detection pipeline
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#include <boost/program_options.hpp>
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <sensor_msgs/LaserScan.h>
+
+#include <gandalf_detector/DetectorNodeParams.h>
+#include <gandalf_detector/YamlParams.h>
+#include <gandalf_detector/ScanConversion.h>
+
+#include <SyntheticScanGenerator.h>
+
+using namespace gandalf_detector;
+
+// every allocation with operator new is counted, allocations with malloc (e.g. cv::Mat) are not
+static std::atomic<uint64_t> gAllocations(0);
+
+void* operator new(std::size_t size){
+	gAllocations++;
+	void* p = std::malloc(size > 0 ? size : 1);
+	if(p == NULL)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void* p) throw(){
+	std::free(p);
+}
+
+/**
+ * the scans of one benchmark input and everything precomputed the micro benchmarks start from
+ */
+struct ScanSet{
+	std::string mName;
+	std::vector<RangeScan> mScans;
+	std::vector<std::vector<float> > mAngles;
+	std::vector<std::vector<SegmentCandidate> > mCandidates;
+	std::vector<std::vector<GDIFeatures> > mBoxes; ///< the valid boxes of the candidates
+	std::vector<std::vector<std::vector<float> > > mFeatures; ///< the features of mBoxes
+	std::vector<std::vector<GDIFeatures> > mDecimatedBoxes; ///< mBoxes with BoundingBoxParams::mFeatureResolution
+	double mMeanFeatureError; ///< [m] mean absolute difference of the decimated features to mFeatures
+	double mMaxFeatureError; ///< [m]
+	double mMaxGeometryError; ///< [rad] largest difference of the border angles of the tabulated boxes to mBoxes
+	double mMaxGeometryFeatureError; ///< [m] largest difference of the features of the tabulated boxes to mFeatures
+
+	/**
+	 * @param featureResolution [rad] for mDecimatedBoxes, 0 for none
+	 * @param geometryTable compared to the exact boxes if it is enabled
+	 */
+	void prepare(DetectorNodeParams const& params, float featureResolution, BoxGeometryTable const& geometryTable){
+		BoundingBoxParams decimatedParams = params.mBoundingBoxParams;
+		decimatedParams.mFeatureResolution = featureResolution;
+		uint64_t features = 0;
+		mMeanFeatureError = 0.0;
+		mMaxFeatureError = 0.0;
+		mMaxGeometryError = 0.0;
+		mMaxGeometryFeatureError = 0.0;
+		mDecimatedBoxes.resize(mScans.size());
+		mAngles.resize(mScans.size());
+		mCandidates.resize(mScans.size());
+		mBoxes.resize(mScans.size());
+		mFeatures.resize(mScans.size());
+		for(uint i = 0; i < mScans.size(); ++i){
+			RangeScanView scan(mScans[i]);
+			for(uint j = 0; j < scan.size(); ++j)
+				mAngles[i].push_back(scan.getAngle(j));
+			uint invalidSegments;
+			mCandidates[i] = getSegmentCandidates(scan, params.mSegmentationParams.mJumpDistance,
+			                                      params.mSegmentationParams.mMinSegmentSize, invalidSegments);
+			for(uint j = 0; j < mCandidates[i].size(); ++j){
+				GDIFeatures box;
+				box.buildBoxFromCenter(scan, mCandidates[i][j].mCenter, params.mBoundingBoxParams);
+				if(!box.isValid())
+					continue;
+				mBoxes[i].push_back(box);
+				box.calcRadialFeatures(scan, mAngles[i]);
+				mFeatures[i].push_back(box.getRadialFeatures());
+				if(geometryTable.isEnabled()){
+					GDIFeatures tabulatedBox;
+					tabulatedBox.buildBoxFromCenter(scan, mCandidates[i][j].mCenter, params.mBoundingBoxParams, &geometryTable);
+					mMaxGeometryError = std::max(mMaxGeometryError, (double)std::abs(tabulatedBox.getMinAngle() - box.getMinAngle()));
+					mMaxGeometryError = std::max(mMaxGeometryError, (double)std::abs(tabulatedBox.getMaxAngle() - box.getMaxAngle()));
+					tabulatedBox.calcRadialFeatures(scan, mAngles[i]);
+					std::vector<float> tabulatedFeatures = tabulatedBox.getRadialFeatures();
+					for(uint f = 0; f < tabulatedFeatures.size(); ++f){
+						// a bin without beams in only one of the boxes counts as the full height
+						double error = std::isnan(tabulatedFeatures[f]) != std::isnan(mFeatures[i].back()[f]) ? params.mBoundingBoxParams.mBoxHeight
+						             : std::isnan(tabulatedFeatures[f]) ? 0.0 : std::abs(tabulatedFeatures[f] - mFeatures[i].back()[f]);
+						mMaxGeometryFeatureError = std::max(mMaxGeometryFeatureError, error);
+					}
+				}
+				if(featureResolution <= 0.0f)
+					continue;
+				GDIFeatures decimatedBox;
+				decimatedBox.buildBoxFromCenter(scan, mCandidates[i][j].mCenter, decimatedParams);
+				mDecimatedBoxes[i].push_back(decimatedBox);
+				decimatedBox.calcRadialFeatures(scan, mAngles[i]);
+				std::vector<float> decimatedFeatures = decimatedBox.getRadialFeatures();
+				for(uint f = 0; f < decimatedFeatures.size(); ++f){
+					double error = std::abs(decimatedFeatures[f] - mFeatures[i].back()[f]);
+					mMeanFeatureError += error;
+					mMaxFeatureError = std::max(mMaxFeatureError, error);
+					features++;
+				}
+			}
+		}
+		if(features > 0)
+			mMeanFeatureError /= features;
+	}
+
+	double getMeanBeams() const {
+		double beams = 0.0;
+		for(uint i = 0; i < mScans.size(); ++i)
+			beams += mScans[i].range.size();
+		return mScans.empty() ? 0.0 : beams / mScans.size();
+	}
+};
+
+struct BenchmarkResult{
+	std::string mScanSet;
+	std::string mBenchmark;
+	double mBeams; ///< mean number of beams per scan
+	uint64_t mScans; ///< processed scans, all repetitions
+	uint64_t mCandidates; ///< processed candidates, all repetitions
+	double mNanoseconds;
+	uint64_t mAllocations;
+};
+
+/**
+ * the benchmarked functions process scan i of the set and return the number of processed candidates
+ */
+typedef boost::function<uint (ScanSet const&, uint)> BenchmarkFunction;
+
+uint benchmarkBreakPoints(DetectorNodeParams const& params, ScanSet const& set, uint i){
+	std::vector<uint> breakPoints = getBreakPoints(set.mScans[i], params.mSegmentationParams.mJumpDistance);
+	return set.mCandidates[i].size();
+}
+
+uint benchmarkSegmentsCenter(DetectorNodeParams const& params, ScanSet const& set, uint i){
+	std::vector<Point2f> centers = getRangeSegmentsCenter(set.mScans[i], params.mSegmentationParams.mJumpDistance,
+	                                                      params.mSegmentationParams.mMinSegmentSize);
+	return centers.size();
+}
+
+// an empty geometry table calculates the exact angles
+uint benchmarkBoxFromCenter(DetectorNodeParams const& params, BoxGeometryTable const& geometryTable, ScanSet const& set, uint i){
+	RangeScanView scan(set.mScans[i]);
+	std::vector<SegmentCandidate> const& candidates = set.mCandidates[i];
+	for(uint j = 0; j < candidates.size(); ++j){
+		GDIFeatures box;
+		box.buildBoxFromCenter(scan, candidates[j].mCenter, params.mBoundingBoxParams, &geometryTable);
+	}
+	return candidates.size();
+}
+
+uint benchmarkBoxFromLeft(DetectorNodeParams const& params, ScanSet const& set, uint i){
+	RangeScanView scan(set.mScans[i]);
+	std::vector<SegmentCandidate> const& candidates = set.mCandidates[i];
+	for(uint j = 0; j < candidates.size(); ++j){
+		GDIFeatures box;
+		box.buildBoxFromLeft(scan, candidates[j].mCenter, params.mBoundingBoxParams);
+	}
+	return candidates.size();
+}
+
+// calcRadialFeatures() accumulates into the box, so it runs on a copy of the prepared box
+uint benchmarkRadialFeatures(ScanSet const& set, uint i){
+	RangeScanView scan(set.mScans[i]);
+	std::vector<GDIFeatures> const& boxes = set.mBoxes[i];
+	for(uint j = 0; j < boxes.size(); ++j){
+		GDIFeatures box(boxes[j]);
+		box.calcRadialFeatures(scan, set.mAngles[i]);
+	}
+	return boxes.size();
+}
+
+uint benchmarkDecimatedRadialFeatures(ScanSet const& set, uint i){
+	RangeScanView scan(set.mScans[i]);
+	std::vector<GDIFeatures> const& boxes = set.mDecimatedBoxes[i];
+	for(uint j = 0; j < boxes.size(); ++j){
+		GDIFeatures box(boxes[j]);
+		box.calcRadialFeatures(scan, set.mAngles[i]);
+	}
+	return boxes.size();
+}
+
+uint benchmarkClassifier(AdaboostClassifierNode const& classifier, ScanSet const& set, uint i){
+	std::vector<std::vector<float> > const& features = set.mFeatures[i];
+	for(uint j = 0; j < features.size(); ++j)
+		classifier.apply(features[j]);
+	return features.size();
+}
+
+uint benchmarkClassifyScan(GDIFDetectorTree& detector, ScanSet const& set, uint i){
+	std::vector<GDIFDetection> detections;
+	detector.classifyScan(set.mScans[i], detections);
+	return detector.getStatistics().mCandidates;
+}
+
+/**
+ * runs the function over all scans of the set, repeated until minTime [s] passed
+ */
+BenchmarkResult runBenchmark(std::string const& name, ScanSet const& set, double minTime, BenchmarkFunction const& function){
+	typedef std::chrono::steady_clock Clock;
+	BenchmarkResult result;
+	result.mScanSet = set.mName;
+	result.mBenchmark = name;
+	result.mBeams = set.getMeanBeams();
+	result.mScans = 0;
+	result.mCandidates = 0;
+	result.mAllocations = 0;
+	result.mNanoseconds = 0.0;
+	if(set.mScans.empty())
+		return result;
+
+	// one warm up run, e.g. for the angle cache of the detector
+	for(uint i = 0; i < set.mScans.size(); ++i)
+		function(set, i);
+
+	Clock::time_point start = Clock::now();
+	uint64_t allocations = gAllocations;
+	do{
+		for(uint i = 0; i < set.mScans.size(); ++i)
+			result.mCandidates += function(set, i);
+		result.mScans += set.mScans.size();
+		result.mNanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count();
+	}while(result.mNanoseconds < minTime * 1e9);
+	result.mAllocations = gAllocations - allocations;
+	return result;
+}
+
+int main(int argc, char** argv){
+	namespace po = boost::program_options;
+
+	std::string tParamFile;
+	std::vector<std::string> tParamOverrides;
+	std::string tBagFile;
+	std::string tTopic;
+	std::string tOutputFile;
+	std::vector<uint> tBeams;
+	std::vector<uint> tPeople;
+	SyntheticScanParams tSyntheticParams;
+	float tFieldOfView;
+	uint tSyntheticScans;
+	double tMinTime;
+	float tFeatureResolution;
+	int tGeometryTableSize;
+
+	po::options_description tOptions("gandalf_benchmark [options]");
+	tOptions.add_options()
+		("help,h", "print this help")
+		("params,p", po::value<std::string>(&tParamFile)->required(), "rosparam YAML file of the detector, e.g. launch/stub_parameter.yaml")
+		("param,s", po::value<std::vector<std::string> >(&tParamOverrides), "overrides a parameter of the YAML file, e.g. -s JumpDistance=0.1")
+		("bag", po::value<std::string>(&tBagFile), "bag file with real scans, e.g. launch/2014-08-18_follow.bag")
+		("topic,t", po::value<std::string>(&tTopic)->default_value("/laser"), "topic of the laser scans in the bag file")
+		("beams", po::value<std::vector<uint> >(&tBeams)->multitoken(), "beam counts of the synthetic scans (default 360 720 1440 2880 3600)")
+		("people", po::value<std::vector<uint> >(&tPeople)->multitoken(), "people without walking aid in the synthetic scans (default 5 40)")
+		("wheelchairs", po::value<uint>(&tSyntheticParams.mWheelchairs)->default_value(2), "people in a wheelchair in the synthetic scans")
+		("walkers", po::value<uint>(&tSyntheticParams.mWalkers)->default_value(2), "people with a walker in the synthetic scans")
+		("clutter", po::value<uint>(&tSyntheticParams.mClutter)->default_value(5), "round objects in the synthetic scans")
+		("fov", po::value<float>(&tFieldOfView)->default_value(270.0f), "field of view of the synthetic scans [deg]")
+		("noise", po::value<float>(&tSyntheticParams.mNoise)->default_value(0.01f), "range noise of the synthetic scans [m]")
+		("scans", po::value<uint>(&tSyntheticScans)->default_value(100), "synthetic scans per beam count and clutter")
+		("min-time", po::value<double>(&tMinTime)->default_value(1.0), "minimum time of a benchmark [s]")
+		("feature-resolution", po::value<float>(&tFeatureResolution)->default_value(0.0f), "additionally benchmarks the features decimated to this resolution [deg] and reports their error, 0 for none")
+		("box-geometry-table", po::value<int>(&tGeometryTableSize)->default_value(0), "additionally benchmarks buildBoxFromCenter with a geometry table of this size (see BoxGeometryTableSize) and reports its error, 0 for none")
+		("output,o", po::value<std::string>(&tOutputFile), "CSV output file, default stdout");
+
+	try{
+		po::variables_map tVariables;
+		po::store(po::parse_command_line(argc, argv, tOptions), tVariables);
+		if(tVariables.count("help")){
+			std::cout << tOptions << std::endl;
+			return 0;
+		}
+		po::notify(tVariables);
+	}
+	catch(po::error const& e){
+		std::cerr << e.what() << std::endl << tOptions << std::endl;
+		return 1;
+	}
+	if(tBeams.empty()){
+		tBeams.push_back(360);
+		tBeams.push_back(720);
+		tBeams.push_back(1440);
+		tBeams.push_back(2880);
+		tBeams.push_back(3600);
+	}
+	if(tPeople.empty()){
+		tPeople.push_back(5);
+		tPeople.push_back(40);
+	}
+	tSyntheticParams.mFieldOfView = tFieldOfView * M_PI / 180.0;
+	ros::Time::init();
+
+	DetectorNodeParams tParams;
+	try{
+		YamlParams tYamlParams(tParamFile);
+		for(uint i = 0; i < tParamOverrides.size(); ++i){
+			std::size_t tSeparator = tParamOverrides[i].find('=');
+			if(tSeparator == std::string::npos){
+				ROS_ERROR("invalid parameter [%s], expected Name=value", tParamOverrides[i].c_str());
+				return 1;
+			}
+			tYamlParams.setParam(tParamOverrides[i].substr(0, tSeparator), tParamOverrides[i].substr(tSeparator + 1));
+		}
+		readDetectorNodeParams(tYamlParams, tParams);
+	}
+	catch(YAML::Exception const& e){
+		ROS_ERROR("could not read parameter file [%s]: %s", tParamFile.c_str(), e.what());
+		return 1;
+	}
+	if(!tParams.getRootClassifierParams()){
+		ROS_ERROR("no classifier in parameter file [%s]", tParamFile.c_str());
+		return 1;
+	}
+
+	std::vector<ScanSet> tScanSets;
+	if(!tBagFile.empty()){
+		ScanSet tSet;
+		tSet.mName = "bag";
+		try{
+			rosbag::Bag tBag;
+			tBag.open(tBagFile, rosbag::bagmode::Read);
+			rosbag::View tView(tBag, rosbag::TopicQuery(tTopic));
+			for(rosbag::View::iterator it = tView.begin(); it != tView.end(); ++it){
+				sensor_msgs::LaserScanConstPtr tScan = it->instantiate<sensor_msgs::LaserScan>();
+				if(!tScan)
+					continue;
+				tSet.mScans.push_back(RangeScan());
+				convertScan(*tScan, tSet.mScans.back());
+			}
+		}
+		catch(rosbag::BagException const& e){
+			ROS_ERROR("could not read bag file [%s]: %s", tBagFile.c_str(), e.what());
+			return 1;
+		}
+		tScanSets.push_back(tSet);
+	}
+	// fixed seed, so every run benchmarks the same scans
+	SyntheticScanGenerator tGenerator(42);
+	for(uint b = 0; b < tBeams.size(); ++b){
+		for(uint p = 0; p < tPeople.size(); ++p){
+			ScanSet tSet;
+			std::ostringstream tName;
+			tName << "synthetic_" << tBeams[b] << "_" << tPeople[p];
+			tSet.mName = tName.str();
+			tSyntheticParams.mBeams = tBeams[b];
+			tSyntheticParams.mPeople = tPeople[p];
+			tGenerator.initialize(tSyntheticParams);
+			tSet.mScans.resize(tSyntheticScans);
+			for(uint i = 0; i < tSyntheticScans; ++i)
+				tGenerator.generate(tSet.mScans[i]);
+			tScanSets.push_back(tSet);
+		}
+	}
+
+	GDIFDetectorTree tDetector;
+	initializeDetector(tDetector, tParams);
+	AdaboostClassifierNode const& tClassifier = *tDetector.getClassifier();
+	BoxGeometryTable tExactGeometry;
+	BoxGeometryTable tGeometryTable;
+	if(tGeometryTableSize > 0){
+		BoundingBoxParams tTableParams = tParams.mBoundingBoxParams;
+		tTableParams.mGeometryTableSize = tGeometryTableSize;
+		tGeometryTable.initialize(tTableParams);
+	}
+
+	std::ofstream tFile;
+	if(!tOutputFile.empty()){
+		tFile.open(tOutputFile.c_str());
+		if(!tFile){
+			ROS_ERROR("could not open output file [%s]", tOutputFile.c_str());
+			return 1;
+		}
+	}
+	std::ostream& tOutput = tOutputFile.empty() ? std::cout : tFile;
+	tOutput << "scan_set,benchmark,beams,scans,candidates_per_scan,ns_per_scan,ns_per_candidate,allocs_per_scan" << std::endl;
+
+	for(uint s = 0; s < tScanSets.size(); ++s){
+		ScanSet& tSet = tScanSets[s];
+		tSet.prepare(tParams, tFeatureResolution * M_PI / 180.0, tGeometryTable);
+		if(tFeatureResolution > 0.0f){
+			ROS_INFO("%s: features decimated to %.2f deg differ by %.4f m on average, %.4f m at most",
+			         tSet.mName.c_str(), tFeatureResolution, tSet.mMeanFeatureError, tSet.mMaxFeatureError);
+		}
+		if(tGeometryTable.isEnabled()){
+			ROS_INFO("%s: box angles of the geometry table differ by %g rad at most (interpolation bound %g rad), the features by %.4f m at most",
+			         tSet.mName.c_str(), tSet.mMaxGeometryError, tGeometryTable.getMaxError(), tSet.mMaxGeometryFeatureError);
+		}
+
+		std::vector<BenchmarkResult> tResults;
+		tResults.push_back(runBenchmark("getBreakPoints", tSet, tMinTime, boost::bind(&benchmarkBreakPoints, boost::cref(tParams), _1, _2)));
+		tResults.push_back(runBenchmark("getRangeSegmentsCenter", tSet, tMinTime, boost::bind(&benchmarkSegmentsCenter, boost::cref(tParams), _1, _2)));
+		tResults.push_back(runBenchmark("buildBoxFromCenter", tSet, tMinTime, boost::bind(&benchmarkBoxFromCenter, boost::cref(tParams), boost::cref(tExactGeometry), _1, _2)));
+		if(tGeometryTable.isEnabled())
+			tResults.push_back(runBenchmark("buildBoxFromCenter table", tSet, tMinTime, boost::bind(&benchmarkBoxFromCenter, boost::cref(tParams), boost::cref(tGeometryTable), _1, _2)));
+		tResults.push_back(runBenchmark("buildBoxFromLeft", tSet, tMinTime, boost::bind(&benchmarkBoxFromLeft, boost::cref(tParams), _1, _2)));
+		tResults.push_back(runBenchmark("calcRadialFeatures", tSet, tMinTime, &benchmarkRadialFeatures));
+		if(tFeatureResolution > 0.0f)
+			tResults.push_back(runBenchmark("calcRadialFeatures decimated", tSet, tMinTime, &benchmarkDecimatedRadialFeatures));
+		tResults.push_back(runBenchmark("AdaboostClassifierNode::apply", tSet, tMinTime, boost::bind(&benchmarkClassifier, boost::cref(tClassifier), _1, _2)));
+		tResults.push_back(runBenchmark("classifyScan", tSet, tMinTime, boost::bind(&benchmarkClassifyScan, boost::ref(tDetector), _1, _2)));
+
+		for(uint r = 0; r < tResults.size(); ++r){
+			BenchmarkResult const& tResult = tResults[r];
+			if(tResult.mScans == 0)
+				continue;
+			tOutput << tResult.mScanSet << "," << tResult.mBenchmark << "," << tResult.mBeams << "," << tSet.mScans.size()
+			        << "," << (double)tResult.mCandidates / tResult.mScans
+			        << "," << tResult.mNanoseconds / tResult.mScans
+			        << "," << (tResult.mCandidates > 0 ? tResult.mNanoseconds / tResult.mCandidates : 0.0)
+			        << "," << (double)tResult.mAllocations / tResult.mScans << std::endl;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file gandalf_compare_detections.cpp
+ *    compares the detections of gandalf_offline_detector with reference detections
+ */
+
+#include <cmath>
+#include <fstream>
+#include <iostream>
+#include <map>
+
+#include <boost/program_options.hpp>
+
+#include <gandalf_detector/DetectionFile.h>
+
+using namespace gandalf_detector;
+
+typedef std::map<uint64_t, std::vector<DetectionFileEntry> > ScanDetections;
+
+bool readScanDetections(std::string const& fileName, ScanDetections& oScans){
+	std::ifstream file(fileName.c_str());
+	if(!file){
+		std::cerr << "could not open [" << fileName << "]" << std::endl;
+		return false;
+	}
+	std::vector<DetectionFileEntry> entries;
+	if(!readDetectionFile(file, entries)){
+		std::cerr << "could not parse line " << entries.size() + 1 << " of [" << fileName << "]" << std::endl;
+		return false;
+	}
+	for(uint i = 0; i < entries.size(); ++i)
+		oScans[entries[i].mScan].push_back(entries[i]);
+	return true;
+}
+
+std::ostream& operator<<(std::ostream& out, DetectionFileEntry const& entry){
+	GDIFDetection const& detection = entry.mDetection;
+	return out << "(" << detection.mPosition.x() << ", " << detection.mPosition.y() << ") label " << (int)detection.mLabel
+	           << " margin " << detection.mMargin << " path " << detection.mPath << " depth " << (int)detection.mDepth;
+}
+
+/**
+ * compares the detections of one scan in exact mode: same number, order and values
+ * @return number of differences, every difference is reported
+ */
+uint compareExact(uint64_t scan, std::vector<DetectionFileEntry> const& reference, std::vector<DetectionFileEntry> const& test){
+	uint differences = 0;
+	for(uint i = 0; i < std::max(reference.size(), test.size()); ++i){
+		if(i >= test.size()){
+			std::cout << "scan " << scan << ": missing detection " << i << " " << reference[i] << std::endl;
+			differences++;
+			continue;
+		}
+		if(i >= reference.size()){
+			std::cout << "scan " << scan << ": additional detection " << i << " " << test[i] << std::endl;
+			differences++;
+			continue;
+		}
+		GDIFDetection const& r = reference[i].mDetection;
+		GDIFDetection const& t = test[i].mDetection;
+		if(r.mPosition.x() != t.mPosition.x() || r.mPosition.y() != t.mPosition.y() || r.mLabel != t.mLabel ||
+		   r.mMargin != t.mMargin || r.mPath != t.mPath || r.mDepth != t.mDepth){
+			std::cout << "scan " << scan << ": detection " << i << " differs, reference " << reference[i] << ", test " << test[i] << std::endl;
+			differences++;
+		}
+	}
+	return differences;
+}
+
+/**
+ * compares the detections of one scan with tolerances: every reference detection is matched to the nearest
+ * test detection of the same label within positionTolerance, the margins of matched detections may differ
+ * by marginTolerance
+ * @return number of differences, every difference is reported
+ */
+uint compareTolerance(uint64_t scan, std::vector<DetectionFileEntry> const& reference, std::vector<DetectionFileEntry> const& test,
+                      float positionTolerance, float marginTolerance){
+	uint differences = 0;
+	std::vector<bool> matched(test.size(), false);
+	for(uint i = 0; i < reference.size(); ++i){
+		GDIFDetection const& r = reference[i].mDetection;
+		int best = -1;
+		float bestDistance = positionTolerance;
+		for(uint j = 0; j < test.size(); ++j){
+			GDIFDetection const& t = test[j].mDetection;
+			if(matched[j] || t.mLabel != r.mLabel)
+				continue;
+			float distance = std::hypot(t.mPosition.x() - r.mPosition.x(), t.mPosition.y() - r.mPosition.y());
+			if(distance <= bestDistance){
+				best = j;
+				bestDistance = distance;
+			}
+		}
+		if(best < 0){
+			std::cout << "scan " << scan << ": missing detection " << reference[i] << std::endl;
+			differences++;
+			continue;
+		}
+		matched[best] = true;
+		if(std::abs(test[best].mDetection.mMargin - r.mMargin) > marginTolerance){
+			std::cout << "scan " << scan << ": margin differs by " << test[best].mDetection.mMargin - r.mMargin
+			          << ", reference " << reference[i] << ", test " << test[best] << std::endl;
+			differences++;
+		}
+	}
+	for(uint j = 0; j < test.size(); ++j){
+		if(!matched[j]){
+			std::cout << "scan " << scan << ": additional detection " << test[j] << std::endl;
+			differences++;
+		}
+	}
+	return differences;
+}
+
+int main(int argc, char** argv){
+	namespace po = boost::program_options;
+
+	std::string tReferenceFile;
+	std::string tTestFile;
+	float tPositionTolerance;
+	float tMarginTolerance;
+
+	po::options_description tOptions("gandalf_compare_detections [options] reference test");
+	tOptions.add_options()
+		("help,h", "print this help")
+		("exact", "the detections have to be identical, in the same order (default)")
+		("tolerance", "match the detections with the tolerances")
+		("position-tolerance", po::value<float>(&tPositionTolerance)->default_value(0.01f), "maximum position difference [m] in tolerance mode")
+		("margin-tolerance", po::value<float>(&tMarginTolerance)->default_value(0.05f), "maximum margin difference in tolerance mode")
+		("reference", po::value<std::string>(&tReferenceFile)->required(), "reference detections")
+		("test", po::value<std::string>(&tTestFile)->required(), "detections to compare");
+	po::positional_options_description tPositional;
+	tPositional.add("reference", 1);
+	tPositional.add("test", 1);
+
+	bool tExact = true;
+	try{
+		po::variables_map tVariables;
+		po::store(po::command_line_parser(argc, argv).options(tOptions).positional(tPositional).run(), tVariables);
+		if(tVariables.count("help")){
+			std::cout << tOptions << std::endl;
+			return 0;
+		}
+		po::notify(tVariables);
+		tExact = tVariables.count("tolerance") == 0;
+	}
+	catch(po::error const& e){
+		std::cerr << e.what() << std::endl << tOptions << std::endl;
+		return 2;
+	}
+
+	// the differences of exact mode may be in the last digits
+	std::cout.precision(9);
+
+	ScanDetections tReference;
+	ScanDetections tTest;
+	if(!readScanDetections(tReferenceFile, tReference) || !readScanDetections(tTestFile, tTest))
+		return 2;
+
+	// scans without detections have no line, so every scan of one of the files is compared
+	std::vector<DetectionFileEntry> const tNone;
+	uint64_t tDifferences = 0;
+	uint64_t tDifferentScans = 0;
+	uint64_t tReferenceDetections = 0;
+	ScanDetections::const_iterator r = tReference.begin();
+	ScanDetections::const_iterator t = tTest.begin();
+	while(r != tReference.end() || t != tTest.end()){
+		uint64_t scan;
+		std::vector<DetectionFileEntry> const* reference = &tNone;
+		std::vector<DetectionFileEntry> const* test = &tNone;
+		if(t == tTest.end() || (r != tReference.end() && r->first <= t->first)){
+			scan = r->first;
+			reference = &(r++)->second;
+			if(t != tTest.end() && t->first == scan)
+				test = &(t++)->second;
+		}
+		else{
+			scan = t->first;
+			test = &(t++)->second;
+		}
+		if(!reference->empty() && !test->empty() && (reference->front().mHeader.stamp.sec != test->front().mHeader.stamp.sec
+		   || reference->front().mHeader.stamp.nsec != test->front().mHeader.stamp.nsec)){
+			std::cerr << "scan " << scan << " has different stamps, the files are not from the same bag files" << std::endl;
+			return 2;
+		}
+		tReferenceDetections += reference->size();
+		uint differences = tExact ? compareExact(scan, *reference, *test)
+		                          : compareTolerance(scan, *reference, *test, tPositionTolerance, tMarginTolerance);
+		tDifferences += differences;
+		if(differences > 0)
+			tDifferentScans++;
+	}
+
+	std::cout << (tExact ? "exact" : "tolerance") << " comparison: " << tDifferences << " differences in "
+	          << tDifferentScans << " scans, " << tReferenceDetections << " reference detections" << std::endl;
+	return tDifferences > 0 ? 1 : 0;
+}
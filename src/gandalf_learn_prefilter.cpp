@@ -0,0 +1,228 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file gandalf_learn_prefilter.cpp
+ *    learns the thresholds of the geometric pre-filter from the foreground segments of bag files
+ */
+
+#include <fstream>
+#include <iostream>
+
+#include <boost/program_options.hpp>
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <sensor_msgs/LaserScan.h>
+
+#include <gandalf_detector/DetectorNodeParams.h>
+#include <gandalf_detector/YamlParams.h>
+#include <gandalf_detector/ScanConversion.h>
+
+#include <OnlineBackgroundModel.h>
+#include <SegmentPreFilter.h>
+#include <Segmentation.h>
+
+using namespace gandalf_detector;
+
+/**
+ * labels the segments of the scans of a fixed sensor by an online background model and keeps the
+ * segments which would become candidates of the detector
+ */
+class PreFilterTrainingSet{
+public:
+	PreFilterTrainingSet(DetectorNodeParams const& params) : mParams(params), mAngularResolution(0.0f), mOtherGeometryScans(0){
+		mBackgroundModel.initialize(params.mBackgroundModelParams);
+	}
+
+	void add(sensor_msgs::LaserScan const& laserScan){
+		if(mAngularResolution == 0.0f)
+			mAngularResolution = laserScan.angle_increment;
+		if(laserScan.angle_increment != mAngularResolution){
+			// the thresholds are learned for one angular resolution
+			mOtherGeometryScans++;
+			return;
+		}
+		mBackgroundModel.update(getScanView(laserScan));
+		if(!mBackgroundModel.isReady())
+			return;
+
+		RangeScan tRangeScan;
+		convertScan(laserScan, tRangeScan);
+		RangeScanWithBackgroundModel tScan(tRangeScan);
+		mBackgroundModel.fillBackgroundModel(tScan);
+		std::vector<RangeSegmentLabeled> tSegments = getLabeledRangeSegments(tScan,
+				mParams.mSegmentationParams.mJumpDistance, mParams.mSegmentationParams.mBackgroundJumpDistance);
+		for(uint i = 0; i < tSegments.size(); ++i){
+			if(tSegments[i].size() < mParams.mSegmentationParams.mMinSegmentSize)
+				continue;
+			SegmentShape tShape = SegmentPreFilter::getShape(tSegments[i], mAngularResolution);
+			if(tShape.mMeanRange > mParams.mSegmentationParams.mMaxRange)
+				continue;
+			if(tSegments[i].getLabel() == SegmentLabel::FG)
+				mForeground.push_back(tSegments[i]);
+			else
+				mBackground.push_back(tShape);
+		}
+	}
+
+	std::vector<RangeSegmentLabeled> const& getForeground() const {return mForeground;}
+	std::vector<SegmentShape> const& getBackground() const {return mBackground;}
+	float getAngularResolution() const {return mAngularResolution;}
+	uint getOtherGeometryScans() const {return mOtherGeometryScans;}
+
+private:
+	DetectorNodeParams const& mParams;
+	OnlineBackgroundModel mBackgroundModel;
+	float mAngularResolution; ///< of the first scan [rad]
+	uint mOtherGeometryScans; ///< scans skipped for another angular resolution
+	std::vector<RangeSegmentLabeled> mForeground;
+	std::vector<SegmentShape> mBackground;
+};
+
+int main(int argc, char** argv){
+	namespace po = boost::program_options;
+
+	std::vector<std::string> tBagFiles;
+	std::vector<std::string> tParamOverrides;
+	std::string tParamFile;
+	std::string tOutputFile;
+	std::string tTopic;
+	double tMargin;
+
+	po::options_description tOptions("gandalf_learn_prefilter [options] bag files");
+	tOptions.add_options()
+		("help,h", "print this help")
+		("params,p", po::value<std::string>(&tParamFile)->required(), "rosparam YAML file of the detector, e.g. launch/stub_parameter.yaml")
+		("param,s", po::value<std::vector<std::string> >(&tParamOverrides), "overrides a parameter of the YAML file, e.g. -s BackgroundJumpDistance=0.3")
+		("output,o", po::value<std::string>(&tOutputFile)->default_value("prefilter_parameter.yaml"), "output file of the learned parameters")
+		("topic,t", po::value<std::string>(&tTopic)->default_value("/laser"), "topic of the laser scans")
+		("margin,m", po::value<double>(&tMargin)->default_value(0.1), "relative safety margin added to the learned bounds")
+		("bags", po::value<std::vector<std::string> >(&tBagFiles), "bag files of a sensor which does not move");
+	po::positional_options_description tPositional;
+	tPositional.add("bags", -1);
+
+	try{
+		po::variables_map tVariables;
+		po::store(po::command_line_parser(argc, argv).options(tOptions).positional(tPositional).run(), tVariables);
+		if(tVariables.count("help") || !tVariables.count("bags")){
+			std::cout << tOptions << std::endl;
+			return tVariables.count("help") ? 0 : 1;
+		}
+		po::notify(tVariables);
+	}
+	catch(po::error const& e){
+		std::cerr << e.what() << std::endl << tOptions << std::endl;
+		return 1;
+	}
+
+	// only for the stamps of the messages, nothing waits for a clock
+	ros::Time::init();
+
+	DetectorNodeParams tParams;
+	try{
+		YamlParams tYamlParams(tParamFile);
+		for(uint i = 0; i < tParamOverrides.size(); ++i){
+			std::size_t tSeparator = tParamOverrides[i].find('=');
+			if(tSeparator == std::string::npos){
+				ROS_ERROR("invalid parameter [%s], expected Name=value", tParamOverrides[i].c_str());
+				return 1;
+			}
+			tYamlParams.setParam(tParamOverrides[i].substr(0, tSeparator), tParamOverrides[i].substr(tSeparator + 1));
+		}
+		readDetectorNodeParams(tYamlParams, tParams);
+	}
+	catch(YAML::Exception const& e){
+		ROS_ERROR("could not read parameter file [%s]: %s", tParamFile.c_str(), e.what());
+		return 1;
+	}
+
+	PreFilterTrainingSet tTrainingSet(tParams);
+	for(uint b = 0; b < tBagFiles.size(); ++b){
+		rosbag::Bag tBag;
+		try{
+			tBag.open(tBagFiles[b], rosbag::bagmode::Read);
+		}
+		catch(rosbag::BagException const& e){
+			ROS_ERROR("could not open bag file [%s]: %s", tBagFiles[b].c_str(), e.what());
+			return 1;
+		}
+		rosbag::View tView(tBag, rosbag::TopicQuery(tTopic));
+		for(rosbag::View::iterator it = tView.begin(); it != tView.end(); ++it){
+			sensor_msgs::LaserScanConstPtr tScan = it->instantiate<sensor_msgs::LaserScan>();
+			if(tScan)
+				tTrainingSet.add(*tScan);
+		}
+	}
+	if(tTrainingSet.getOtherGeometryScans() > 0){
+		ROS_WARN("skipped %u scans with another angular resolution than %f rad",
+		         tTrainingSet.getOtherGeometryScans(), tTrainingSet.getAngularResolution());
+	}
+	if(tTrainingSet.getForeground().empty()){
+		ROS_ERROR("no foreground segments found in topic [%s], is the sensor fixed and are there objects in front of the background?", tTopic.c_str());
+		return 1;
+	}
+
+	SegmentPreFilterParams tPreFilterParams = SegmentPreFilter::learnParams(tTrainingSet.getForeground(),
+			tTrainingSet.getAngularResolution(), tParams.mPreFilterParams.mLinearityMinWidth, tMargin);
+	SegmentPreFilter tPreFilter;
+	tPreFilter.initialize(tPreFilterParams);
+	uint tRejected = 0;
+	for(uint i = 0; i < tTrainingSet.getBackground().size(); ++i){
+		if(!tPreFilter.accept(tTrainingSet.getBackground()[i]))
+			tRejected++;
+	}
+	ROS_INFO("learned from %lu foreground segments, %u of %lu background segments (%.1f%%) are rejected",
+	         (unsigned long)tTrainingSet.getForeground().size(), tRejected, (unsigned long)tTrainingSet.getBackground().size(),
+	         tTrainingSet.getBackground().empty() ? 0.0 : 100.0 * tRejected / tTrainingSet.getBackground().size());
+
+	std::ofstream tOutput(tOutputFile.c_str());
+	if(!tOutput){
+		ROS_ERROR("could not open output file [%s]", tOutputFile.c_str());
+		return 1;
+	}
+	tOutput << "UsePreFilter: true" << std::endl;
+	tOutput << "PreFilterMaxSegmentWidth: " << tPreFilterParams.mMaxSegmentWidth << std::endl;
+	tOutput << "PreFilterMinNormalizedPointCount: " << tPreFilterParams.mMinNormalizedPointCount << std::endl;
+	tOutput << "PreFilterMaxNormalizedPointCount: " << tPreFilterParams.mMaxNormalizedPointCount << std::endl;
+	tOutput << "PreFilterLinearityMinWidth: " << tPreFilterParams.mLinearityMinWidth << std::endl;
+	tOutput << "PreFilterMinLineResidual: " << tPreFilterParams.mMinLineResidual << std::endl;
+	return 0;
+}
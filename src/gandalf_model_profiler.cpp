@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file gandalf_model_profiler.cpp
+ *    profiles the weak learners of the classifier tree on bag files and prunes the models
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <iostream>
+
+#include <boost/filesystem.hpp>
+#include <boost/program_options.hpp>
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <sensor_msgs/LaserScan.h>
+
+#include <gandalf_detector/DetectorNodeParams.h>
+#include <gandalf_detector/YamlParams.h>
+#include <gandalf_detector/ScanConversion.h>
+
+#include <WeakLearnerProfiler.h>
+
+using namespace gandalf_detector;
+
+enum PruningOrder{
+	PRUNE_TAIL, ///< the last learners of the boosting are removed first
+	PRUNE_CONTRIBUTION ///< the learners with the smallest contribution are removed first
+};
+
+/**
+ * the usage of the weak learners of a model file, summed over all nodes using it
+ */
+struct ModelUsage{
+	uint mLearnerCount;
+	std::vector<double> mContributions; ///< sum of the absolute responses by learner
+};
+
+typedef std::map<std::string, ModelUsage> ModelUsages;
+
+/**
+ * orders the learners by decreasing contribution
+ */
+struct ContributionOrder{
+	ContributionOrder(ModelUsage const& usage) : mUsage(usage){}
+
+	bool operator()(uint a, uint b) const {
+		return mUsage.mContributions[a] > mUsage.mContributions[b];
+	}
+
+	ModelUsage const& mUsage;
+};
+
+ModelUsages getModelUsages(WeakLearnerProfiler const& profiler){
+	ModelUsages usages;
+	std::vector<NodeUsage> const& nodes = profiler.getNodes();
+	for(uint n = 0; n < nodes.size(); ++n){
+		if(nodes[n].mNode == NULL)
+			continue;
+		ModelUsage& usage = usages[nodes[n].mNode->getModel().mPath];
+		usage.mLearnerCount = nodes[n].mLearners.size();
+		usage.mContributions.resize(usage.mLearnerCount, 0.0);
+		for(uint i = 0; i < nodes[n].mLearners.size(); ++i)
+			usage.mContributions[i] += nodes[n].mLearners[i].mAbsResponseSum;
+	}
+	return usages;
+}
+
+/**
+ * keeps ceil(fraction * learners) learners of every model, at least one
+ */
+WeakLearnerProfiler::LearnerMasks getLearnerMasks(ModelUsages const& usages, PruningOrder order, double fraction){
+	WeakLearnerProfiler::LearnerMasks masks;
+	for(ModelUsages::const_iterator it = usages.begin(); it != usages.end(); ++it){
+		ModelUsage const& usage = it->second;
+		uint tKeep = std::min<uint>(std::max<uint>((uint)std::ceil(fraction * usage.mLearnerCount - 1e-9), 1), usage.mLearnerCount);
+		std::vector<uint> tRanking(usage.mLearnerCount);
+		for(uint i = 0; i < tRanking.size(); ++i)
+			tRanking[i] = i;
+		if(order == PRUNE_CONTRIBUTION){
+			std::stable_sort(tRanking.begin(), tRanking.end(), ContributionOrder(usage));
+		}
+		std::vector<uint8_t>& mask = masks[it->first];
+		mask.assign(usage.mLearnerCount, 0);
+		for(uint i = 0; i < tKeep; ++i)
+			mask[tRanking[i]] = 1;
+	}
+	return masks;
+}
+
+/**
+ * writes the model with the learners of the mask to the directory, with the file name of the model
+ */
+bool writePrunedModel(std::string const& path, std::vector<uint8_t> const& mask, std::string const& directory){
+	cv::Boost tBoost;
+	tBoost.load(path.c_str());
+	// removed from the back, so the indices of the remaining learners do not change
+	for(int i = (int)mask.size() - 1; i >= 0; --i){
+		if(!mask[i])
+			tBoost.prune(CvSlice(i, i + 1));
+	}
+	std::string tOutput = (boost::filesystem::path(directory) / boost::filesystem::path(path).filename()).string();
+	if(boost::filesystem::exists(tOutput) && boost::filesystem::equivalent(tOutput, path)){
+		ROS_ERROR("the pruned model would overwrite [%s]", path.c_str());
+		return false;
+	}
+	tBoost.save(tOutput.c_str());
+	ROS_INFO("wrote [%s] with [%d] of [%d] weak learners", tOutput.c_str(), (int)std::count(mask.begin(), mask.end(), 1), (int)mask.size());
+	return true;
+}
+
+int main(int argc, char** argv){
+	namespace po = boost::program_options;
+
+	std::vector<std::string> tBagFiles;
+	std::vector<std::string> tParamOverrides;
+	std::string tParamFile;
+	std::string tProfileFile;
+	std::string tCurveFile;
+	std::string tTopic;
+	std::string tOrder;
+	std::string tOutputDirectory;
+	uint tSteps;
+	uint tMaxCandidates;
+	double tKeep;
+
+	po::options_description tOptions("gandalf_model_profiler [options] bag files");
+	tOptions.add_options()
+		("help,h", "print this help")
+		("params,p", po::value<std::string>(&tParamFile)->required(), "rosparam YAML file of the detector, e.g. launch/stub_parameter.yaml")
+		("param,s", po::value<std::vector<std::string> >(&tParamOverrides), "overrides a parameter of the YAML file, e.g. -s JumpDistance=0.1")
+		("topic,t", po::value<std::string>(&tTopic)->default_value("/laser"), "topic of the laser scans")
+		("profile,o", po::value<std::string>(&tProfileFile)->default_value("weak_learners.csv"), "output file of the usage of the weak learners")
+		("curve,c", po::value<std::string>(&tCurveFile)->default_value("pruning_curve.csv"), "output file of the speed/accuracy curve of the pruning")
+		("steps", po::value<uint>(&tSteps)->default_value(20), "number of kept fractions of the curve")
+		("max-candidates", po::value<uint>(&tMaxCandidates)->default_value(200000), "candidates kept for the curve, the profile uses all")
+		("keep,k", po::value<double>(&tKeep)->default_value(0.0), "fraction of the weak learners of every model to write to --output-dir, 0 writes nothing")
+		("order", po::value<std::string>(&tOrder)->default_value("contribution"), "pruning order of --keep: tail or contribution")
+		("output-dir,d", po::value<std::string>(&tOutputDirectory)->default_value("pruned"), "directory of the pruned models")
+		("bags", po::value<std::vector<std::string> >(&tBagFiles), "bag files");
+	po::positional_options_description tPositional;
+	tPositional.add("bags", -1);
+
+	try{
+		po::variables_map tVariables;
+		po::store(po::command_line_parser(argc, argv).options(tOptions).positional(tPositional).run(), tVariables);
+		if(tVariables.count("help") || !tVariables.count("bags")){
+			std::cout << tOptions << std::endl;
+			return tVariables.count("help") ? 0 : 1;
+		}
+		po::notify(tVariables);
+	}
+	catch(po::error const& e){
+		std::cerr << e.what() << std::endl << tOptions << std::endl;
+		return 1;
+	}
+	if(tOrder != "tail" && tOrder != "contribution"){
+		std::cerr << "invalid --order [" << tOrder << "], expected tail or contribution" << std::endl;
+		return 1;
+	}
+
+	// only for the stamps of the messages, nothing waits for a clock
+	ros::Time::init();
+
+	DetectorNodeParams tParams;
+	try{
+		YamlParams tYamlParams(tParamFile);
+		for(uint i = 0; i < tParamOverrides.size(); ++i){
+			std::size_t tSeparator = tParamOverrides[i].find('=');
+			if(tSeparator == std::string::npos){
+				ROS_ERROR("invalid parameter [%s], expected Name=value", tParamOverrides[i].c_str());
+				return 1;
+			}
+			tYamlParams.setParam(tParamOverrides[i].substr(0, tSeparator), tParamOverrides[i].substr(tSeparator + 1));
+		}
+		readDetectorNodeParams(tYamlParams, tParams);
+	}
+	catch(YAML::Exception const& e){
+		ROS_ERROR("could not read parameter file [%s]: %s", tParamFile.c_str(), e.what());
+		return 1;
+	}
+	boost::shared_ptr<AdaboostClassifierNode const> tClassifier = loadClassifier(tParams);
+	if(!tClassifier){
+		ROS_ERROR("could not load the classifier of parameter file [%s]", tParamFile.c_str());
+		return 1;
+	}
+
+	GDIFDetectorTree tDetector;
+	initializeDetector(tDetector, tParams, tClassifier);
+	WeakLearnerProfiler tProfiler;
+	tProfiler.initialize(tClassifier);
+
+	// the features and the labels of the complete models, for the curve
+	std::vector<std::vector<float> > tSamples;
+	std::vector<StageLabel> tLabels;
+	GDIFCandidates tCandidates;
+	uint64_t tNumCandidates = 0;
+	for(uint b = 0; b < tBagFiles.size(); ++b){
+		rosbag::Bag tBag;
+		try{
+			tBag.open(tBagFiles[b], rosbag::bagmode::Read);
+		}
+		catch(rosbag::BagException const& e){
+			ROS_ERROR("could not open bag file [%s]: %s", tBagFiles[b].c_str(), e.what());
+			return 1;
+		}
+		rosbag::View tView(tBag, rosbag::TopicQuery(tTopic));
+		for(rosbag::View::iterator it = tView.begin(); it != tView.end(); ++it){
+			sensor_msgs::LaserScanConstPtr tScan = it->instantiate<sensor_msgs::LaserScan>();
+			if(!tScan)
+				continue;
+			tDetector.extractCandidates(getScanView(*tScan), tCandidates);
+			for(uint i = 0; i < tCandidates.mFeatures.size(); ++i){
+				StageLabel tLabel = tProfiler.add(tCandidates.mFeatures[i]);
+				if(tSamples.size() < tMaxCandidates){
+					tSamples.push_back(tCandidates.mFeatures[i]);
+					tLabels.push_back(tLabel);
+				}
+			}
+			tNumCandidates += tCandidates.mFeatures.size();
+		}
+	}
+	ROS_INFO("profiled [%lu] candidates", (unsigned long)tNumCandidates);
+
+	std::ofstream tProfile(tProfileFile.c_str());
+	if(!tProfile){
+		ROS_ERROR("could not open output file [%s]", tProfileFile.c_str());
+		return 1;
+	}
+	tProfiler.write(tProfile);
+
+	// accuracy relative to the complete models, the classification time is about proportional to the evaluated learners
+	std::ofstream tCurve(tCurveFile.c_str());
+	if(!tCurve){
+		ROS_ERROR("could not open output file [%s]", tCurveFile.c_str());
+		return 1;
+	}
+	tCurve << "order,keep,learners_per_candidate,relative_cost,agreement,lost_detections,added_detections" << std::endl;
+	ModelUsages tUsages = getModelUsages(tProfiler);
+	uint64_t tFullLearners = 0;
+	for(uint i = 0; i < tSamples.size(); ++i)
+		tProfiler.classify(tSamples[i], WeakLearnerProfiler::LearnerMasks(), tFullLearners);
+	for(int o = PRUNE_TAIL; o <= PRUNE_CONTRIBUTION; ++o){
+		for(uint s = std::max(tSteps, 1u); s > 0; --s){
+			double tFraction = (double)s / std::max(tSteps, 1u);
+			WeakLearnerProfiler::LearnerMasks tMasks = getLearnerMasks(tUsages, (PruningOrder)o, tFraction);
+			uint64_t tLearners = 0;
+			uint64_t tAgreements = 0;
+			uint64_t tLost = 0;
+			uint64_t tAdded = 0;
+			for(uint i = 0; i < tSamples.size(); ++i){
+				StageLabel tLabel = tProfiler.classify(tSamples[i], tMasks, tLearners);
+				if(tLabel == tLabels[i])
+					tAgreements++;
+				else if(tLabel == NO_PERSON)
+					tLost++;
+				else if(tLabels[i] == NO_PERSON)
+					tAdded++;
+			}
+			double tCount = std::max<double>(tSamples.size(), 1.0);
+			tCurve << (o == PRUNE_TAIL ? "tail" : "contribution") << "," << tFraction << "," << tLearners / tCount
+			       << "," << (tFullLearners > 0 ? (double)tLearners / tFullLearners : 0.0) << "," << tAgreements / tCount
+			       << "," << tLost << "," << tAdded << std::endl;
+		}
+	}
+
+	if(tKeep > 0.0){
+		boost::filesystem::create_directories(tOutputDirectory);
+		WeakLearnerProfiler::LearnerMasks tMasks = getLearnerMasks(tUsages, tOrder == "tail" ? PRUNE_TAIL : PRUNE_CONTRIBUTION, std::min(tKeep, 1.0));
+		for(WeakLearnerProfiler::LearnerMasks::const_iterator it = tMasks.begin(); it != tMasks.end(); ++it){
+			if(!writePrunedModel(it->first, it->second, tOutputDirectory))
+				return 1;
+		}
+	}
+	return 0;
+}
@@ -0,0 +1,341 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+#include <ros/ros.h>
+#include <sensor_msgs/LaserScan.h>
+#include <geometry_msgs/PoseArray.h>
+#include <visualization_msgs/Marker.h>
+#include <diagnostic_msgs/DiagnosticArray.h>
+#include <tf/transform_listener.h>
+
+#include <GDIFDetectorTree.h>
+
+#include <atomic>
+#include <algorithm>
+#include <boost/asio.hpp>
+#include <boost/thread.hpp>
+#include <boost/scoped_ptr.hpp>
+
+#include <gandalf_detector/Mailbox.h>
+#include <gandalf_detector/DetectorNodeParams.h>
+#include <gandalf_detector/ScanConversion.h>
+#include <gandalf_detector/DetectionPublishers.h>
+#include <gandalf_detector/ModelReloader.h>
+#include <gandalf_detector/Diagnostics.h>
+
+using namespace mira::laserbasedobjectdetection;
+using namespace gandalf_detector;
+
+/**
+ * everything which belongs to one laser scanner, the detectors of all sensors share one classifier tree
+ */
+struct Sensor{
+	Sensor(boost::asio::io_service& ioService) :
+		mStrand(ioService), mMailbox(KEEP_LATEST), mScheduled(false),
+		mLatencySum(0.0), mLatencyMax(0.0), mLatencyCount(0){}
+
+	std::string mName;
+	ros::Subscriber mLaserSub;
+	DetectionPublishers mDetectionPublishers;
+
+	/// the detector keeps the geometry of this sensor and its background model
+	GDIFDetectorTree mDetector;
+	/// template of the published markers, without header and points
+	visualization_msgs::Marker mMarker;
+
+	/// the scans of one sensor are processed in order, never concurrently
+	boost::asio::io_service::strand mStrand;
+	Mailbox<sensor_msgs::LaserScan::ConstPtr> mMailbox;
+	std::atomic<bool> mScheduled;
+
+	boost::mutex mLatencyMutex;
+	double mLatencySum;
+	double mLatencyMax;
+	uint64_t mLatencyCount;
+	GDIFDetectorTotals mDetectorTotals; ///< of the scans since the last diagnostics
+};
+typedef boost::shared_ptr<Sensor> SensorPtr;
+
+/**
+ * one detector node for several laser scanners, the scans of all scanners are processed by a fixed number of threads
+ */
+class GDIFMultiSensorDetectorNode{
+public:
+
+	GDIFMultiSensorDetectorNode() : mNodeHandle("~"), mWork(new boost::asio::io_service::work(mIOService)){
+		mColorPalette = getLabelColorPalette();
+		mMergeOutput = false;
+	}
+
+	~GDIFMultiSensorDetectorNode(){
+		// the callbacks have to be gone before the workers are stopped and the sensors are destroyed
+		mDiagnosticsTimer.stop();
+		for(uint i = 0; i < mSensors.size(); ++i){
+			mSensors[i]->mLaserSub.shutdown();
+		}
+		mWork.reset();
+		mIOService.stop();
+		mWorkers.join_all();
+	}
+
+	/**
+	 * @return false if the classifier tree could not be loaded
+	 */
+	bool init(){
+		int tInt;
+		double tDouble;
+
+		std::vector<std::string> tLaserTopics;
+		mNodeHandle.getParam("LaserTopics", tLaserTopics);
+		if(tLaserTopics.empty()){
+			ROS_ERROR("no param LaserTopics, using [laser]");
+			tLaserTopics.push_back("laser");
+		}
+		mNodeHandle.param("NumThreads", tInt, (int)std::max(1u, boost::thread::hardware_concurrency()));
+		if(tInt < 1){
+			ROS_ERROR("NumThreads [%d] < 1", tInt);
+			tInt = 1;
+		}
+		uint tNumThreads = tInt;
+
+		// all detections in one topic, transformed into MergedFrame
+		mNodeHandle.param("MergeOutput", mMergeOutput, false);
+		mNodeHandle.param("MergedFrame", mMergedFrame, std::string("base_link"));
+		mNodeHandle.param("TransformTimeout", tDouble, 0.1);
+		mTransformTimeout = ros::Duration(tDouble);
+		if(mMergeOutput){
+			mTransformListener.reset(new tf::TransformListener());
+			mDetectionPublishers.advertise(mNodeHandle);
+		}
+
+		// the model is loaded once, every sensor gets its own detector for its geometry and its background
+		readDetectorNodeParams(mNodeHandle, mParams);
+		// loaded by the reloader, so a reload only loads the changed model files
+		boost::shared_ptr<AdaboostClassifierNode const> tClassifier = mModelReloader.loadClassifier(mParams);
+		if(!tClassifier){
+			ROS_ERROR("could not load the classifier tree");
+			return false;
+		}
+
+		for(uint i = 0; i < tLaserTopics.size(); ++i){
+			SensorPtr sensor(new Sensor(mIOService));
+			sensor->mName = getSensorName(tLaserTopics[i]);
+			initializeDetector(sensor->mDetector, mParams, tClassifier);
+			sensor->mMarker = getDetectionMarker();
+			if(mMergeOutput){
+				// one marker per sensor, so they do not replace each other
+				sensor->mMarker.id = i;
+			}
+			else{
+				sensor->mDetectionPublishers.advertise(mNodeHandle, sensor->mName + "/");
+			}
+			mSensors.push_back(sensor);
+		}
+		// a reloaded tree is shared by all sensors again
+		mModelReloader.advertise(mNodeHandle, boost::bind(&GDIFMultiSensorDetectorNode::setClassifier, this, _1));
+
+		for(uint i = 0; i < tNumThreads; ++i){
+			mWorkers.create_thread(boost::bind(&boost::asio::io_service::run, &mIOService));
+		}
+
+		mDiagnosticsTopic = mNodeHandle.advertise<diagnostic_msgs::DiagnosticArray>("/diagnostics", 10);
+		mNodeHandle.param("DiagnosticsPeriod", tDouble, 1.0);
+		mDiagnosticsTimer = mNodeHandle.createTimer(ros::Duration(tDouble), &GDIFMultiSensorDetectorNode::diagnosticsCallback, this);
+
+		for(uint i = 0; i < mSensors.size(); ++i){
+			// the topics are resolved relative to the node namespace like the topic of the single sensor node
+			mSensors[i]->mLaserSub = mNodeHandle.subscribe<sensor_msgs::LaserScan>(tLaserTopics[i], 10,
+					boost::bind(&GDIFMultiSensorDetectorNode::laserCallback, this, _1, mSensors[i]));
+		}
+		ROS_INFO("detecting in [%d] laser topics with [%d] threads", (int)mSensors.size(), (int)tNumThreads);
+		return true;
+	}
+
+	/**
+	 * replaces the classifier tree of all sensors, called by the model reloader
+	 */
+	void setClassifier(boost::shared_ptr<AdaboostClassifierNode const> classifier){
+		for(uint i = 0; i < mSensors.size(); ++i){
+			mSensors[i]->mDetector.setClassifier(classifier);
+		}
+	}
+
+	/**
+	 * @return the topic without leading slash and with the other slashes replaced, e.g. front_scan for /front/scan
+	 */
+	static std::string getSensorName(std::string const& topic){
+		std::string name = topic;
+		while(!name.empty() && name[0] == '/')
+			name.erase(0, 1);
+		std::replace(name.begin(), name.end(), '/', '_');
+		return name;
+	}
+
+	/**
+	 * Keeps only the latest scan of the sensor and schedules its processing if it is not already scheduled.
+	 */
+	void laserCallback(const sensor_msgs::LaserScan::ConstPtr& laserScan, SensorPtr sensor){
+		sensor->mMailbox.post(laserScan);
+		if(!sensor->mScheduled.exchange(true)){
+			sensor->mStrand.post(boost::bind(&GDIFMultiSensorDetectorNode::processSensor, this, sensor));
+		}
+	}
+
+	/**
+	 * runs in the thread pool, the strand of the sensor ensures that its detector is used by one thread at once
+	 */
+	void processSensor(SensorPtr sensor){
+		// reset before the mailbox is checked, a scan which arrives later schedules a new run
+		sensor->mScheduled = false;
+		sensor_msgs::LaserScan::ConstPtr laserScan;
+		if(!sensor->mMailbox.tryTake(laserScan))
+			return;
+
+		std::vector<GDIFDetection> detections;
+		sensor->mDetector.classifyScan(getScanView(*laserScan), detections);
+
+		if(mMergeOutput){
+			publishMerged(*sensor, laserScan->header, detections);
+		}
+		else{
+			sensor->mDetectionPublishers.publish(laserScan->header, detections, mColorPalette, sensor->mMarker);
+		}
+
+		double latency = (ros::Time::now() - laserScan->header.stamp).toSec();
+		boost::lock_guard<boost::mutex> lock(sensor->mLatencyMutex);
+		sensor->mLatencySum += latency;
+		sensor->mLatencyMax = std::max(sensor->mLatencyMax, latency);
+		sensor->mLatencyCount++;
+		sensor->mDetectorTotals.add(sensor->mDetector.getStatistics());
+	}
+
+	/**
+	 * transforms the detections of a sensor into the merged frame and publishes them on the common topic
+	 */
+	void publishMerged(Sensor& sensor, std_msgs::Header const& header, std::vector<GDIFDetection> detections){
+		tf::StampedTransform transform;
+		try{
+			mTransformListener->waitForTransform(mMergedFrame, header.frame_id, header.stamp, mTransformTimeout);
+			mTransformListener->lookupTransform(mMergedFrame, header.frame_id, header.stamp, transform);
+		}
+		catch(tf::TransformException& ex){
+			ROS_WARN_THROTTLE(1.0, "dropping the detections of [%s]: %s", sensor.mName.c_str(), ex.what());
+			return;
+		}
+		for(uint i = 0; i < detections.size(); ++i){
+			tf::Vector3 position = transform * tf::Vector3(detections[i].mPosition.x(), detections[i].mPosition.y(), 0.0);
+			detections[i].mPosition = mira::Point2f(position.x(), position.y());
+		}
+		std_msgs::Header mergedHeader = header;
+		mergedHeader.frame_id = mMergedFrame;
+		mDetectionPublishers.publish(mergedHeader, detections, mColorPalette, sensor.mMarker);
+	}
+
+	/**
+	 * Publishes the dropped scans and the latency of every sensor since the last call.
+	 */
+	void diagnosticsCallback(ros::TimerEvent const&){
+		diagnostic_msgs::DiagnosticArray diagnostics;
+		diagnostics.header.stamp = ros::Time::now();
+		for(uint i = 0; i < mSensors.size(); ++i){
+			Sensor& sensor = *mSensors[i];
+			diagnostic_msgs::DiagnosticStatus status;
+			status.level = diagnostic_msgs::DiagnosticStatus::OK;
+			status.name = ros::this_node::getName() + ": " + sensor.mName;
+			status.hardware_id = sensor.mName;
+			status.values.push_back(makeKeyValue("dropped scans", sensor.mMailbox.getDropped()));
+			boost::lock_guard<boost::mutex> lock(sensor.mLatencyMutex);
+			status.values.push_back(makeKeyValue("processed scans", sensor.mLatencyCount));
+			status.values.push_back(makeKeyValue("mean latency [s]", sensor.mLatencyCount > 0 ? sensor.mLatencySum / sensor.mLatencyCount : 0.0));
+			status.values.push_back(makeKeyValue("max latency [s]", sensor.mLatencyMax));
+			status.values.push_back(makeKeyValue("model reloads", mModelReloader.getReloads()));
+			status.values.push_back(makeKeyValue("failed model reloads", mModelReloader.getFailedReloads()));
+			sensor.mLatencySum = 0.0;
+			sensor.mLatencyMax = 0.0;
+			sensor.mLatencyCount = 0;
+			diagnostics.status.push_back(status);
+			diagnostic_msgs::DiagnosticStatus funnel;
+			funnel.level = diagnostic_msgs::DiagnosticStatus::OK;
+			funnel.name = ros::this_node::getName() + ": " + sensor.mName + " candidates";
+			funnel.hardware_id = sensor.mName;
+			funnel.message = "per scan";
+			addDetectorTotals(funnel, sensor.mDetectorTotals);
+			sensor.mDetectorTotals.reset();
+			diagnostics.status.push_back(funnel);
+		}
+		mDiagnosticsTopic.publish(diagnostics);
+	}
+
+private:
+	ros::NodeHandle mNodeHandle;
+	// declared before the sensors, their strands have to be destroyed first
+	boost::asio::io_service mIOService;
+	boost::scoped_ptr<boost::asio::io_service::work> mWork;
+	boost::thread_group mWorkers;
+
+	DetectionPublishers mDetectionPublishers;
+	ros::Publisher mDiagnosticsTopic;
+	ros::Timer mDiagnosticsTimer;
+
+	DetectorNodeParams mParams;
+	std::vector<SensorPtr> mSensors;
+	// declared after the sensors, its loading thread is joined before they are destroyed
+	ModelReloader mModelReloader;
+
+	bool mMergeOutput;
+	std::string mMergedFrame;
+	ros::Duration mTransformTimeout;
+	boost::scoped_ptr<tf::TransformListener> mTransformListener;
+
+	std::vector<std_msgs::ColorRGBA> mColorPalette;
+};
+
+
+
+int main(int argc, char **argv)
+{
+	ros::init(argc, argv, "GDIFMultiSensorDetector");
+	GDIFMultiSensorDetectorNode tGDIFMultiSensorDetectorNode;
+	if(!tGDIFMultiSensorDetectorNode.init())
+		return 1;
+	ros::spin();
+
+	return 0;
+}
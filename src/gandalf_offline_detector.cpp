@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2014 by
+ *   Neuroinformatics and Cognitive Robotics Labs (NICR) at TU Ilmenau, GERMANY
+ * All rights reserved.
+ *
+ * Contact: christoph.weinrich@tu-ilmenau.de,
+ *          tim.wengefeld@tu-ilmenau.de
+ *
+ * GNU General Public License Usage:
+ *   This file may be used under the terms of the GNU General Public License
+ *   version 3.0 as published by the Free Software Foundation and appearing in
+ *   the file LICENSE.GPL3 included in the packaging of this file. Please review
+ *   the following information to ensure the GNU General Public License
+ *   version 3.0 requirements will be met: http://www.gnu.org/copyleft/gpl.html.
+ *   Alternatively you may (at your option) use any later version of the GNU
+ *   General Public License if such license has been publicly approved by NICR.
+ *
+ * IN NO EVENT SHALL "NICR" BE LIABLE TO ANY PARTY FOR DIRECT, INDIRECT,
+ * SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES ARISING OUT OF THE USE OF THIS
+ * SOFTWARE AND ITS DOCUMENTATION, EVEN IF "NICR" HAS BEEN ADVISED OF THE
+ * POSSIBILITY OF SUCH DAMAGE.
+ *
+ * "NICR" SPECIFICALLY DISCLAIM ANY WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE. THE SOFTWARE PROVIDED HEREUNDER IS ON AN "AS IS" BASIS, AND "NICR"
+ * HAVE NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT, UPDATES, ENHANCEMENTS OR
+ * MODIFICATIONS.
+ */
+
+/*
+ * When using this software for your own research, please acknowledge the effort
+ * that went into its construction by citing the corresponding paper:
+ *
+ *   C. Weinrich, T. Wengefeld, C. Schröter and H.-M. Gross
+ *   People Detection and Distinction of their Walking Aids in 2D Laser Range
+ *   Data based on Generic Distance-Invariant Features.
+ *   In Proceedings of the IEEE International Symposium on Robot and Human
+ *   Interactive Communication (RO-MAN), 2014, Edinburgh (UK)
+ */
+
+/**
+ * @file gandalf_offline_detector.cpp
+ *    runs the detector on the laser scans of bag files as fast as possible, without ROS master
+ */
+
+#include <atomic>
+#include <fstream>
+#include <iostream>
+
+#include <boost/program_options.hpp>
+#include <boost/thread.hpp>
+
+#include <rosbag/bag.h>
+#include <rosbag/view.h>
+#include <sensor_msgs/LaserScan.h>
+
+#include <gandalf_detector/DetectorNodeParams.h>
+#include <gandalf_detector/YamlParams.h>
+#include <gandalf_detector/ScanConversion.h>
+#include <gandalf_detector/DetectionFile.h>
+
+using namespace gandalf_detector;
+
+/**
+ * detects in the scans of a batch in parallel, every thread takes the next unprocessed scan and has
+ * its own detector, all detectors share one classifier tree.
+ * The detections of scan i are stored at index i, so they can be written in the order of the scans.
+ */
+class OfflineDetector{
+public:
+	OfflineDetector(DetectorNodeParams const& params, uint numThreads) : mNextScan(0){
+		boost::shared_ptr<AdaboostClassifierNode> tClassifier(new AdaboostClassifierNode());
+		tClassifier->initialize(params.getRootClassifierParams());
+		ROS_INFO("loaded %u classifier models with %lu kB in %.3f s", tClassifier->getModelCount(),
+				(unsigned long)(tClassifier->getModelBytes() / 1024), tClassifier->getLoadTime());
+		for(uint i = 0; i < std::max(numThreads, 1u); ++i){
+			boost::shared_ptr<GDIFDetectorTree> detector(new GDIFDetectorTree());
+			initializeDetector(*detector, params, tClassifier);
+			mDetectors.push_back(detector);
+			mTotals.push_back(GDIFDetectorTotals());
+		}
+	}
+
+	void detect(std::vector<sensor_msgs::LaserScanConstPtr> const& scans,
+	            std::vector<std::vector<GDIFDetection> >& oDetections){
+		oDetections.resize(scans.size());
+		for(uint i = 0; i < oDetections.size(); ++i)
+			oDetections[i].clear();
+		mNextScan = 0;
+		if(mDetectors.size() == 1){
+			detectLoop(0, scans, oDetections);
+			return;
+		}
+		boost::thread_group workers;
+		for(uint i = 0; i < mDetectors.size(); ++i)
+			workers.create_thread(boost::bind(&OfflineDetector::detectLoop, this, i, boost::cref(scans), boost::ref(oDetections)));
+		workers.join_all();
+	}
+
+	/**
+	 * @return the statistics of all processed scans
+	 */
+	GDIFDetectorTotals getTotals() const {
+		GDIFDetectorTotals totals;
+		for(uint i = 0; i < mTotals.size(); ++i)
+			totals.add(mTotals[i]);
+		return totals;
+	}
+
+private:
+	void detectLoop(uint detectorIndex, std::vector<sensor_msgs::LaserScanConstPtr> const& scans,
+	                std::vector<std::vector<GDIFDetection> >& oDetections){
+		GDIFDetectorTree& detector = *mDetectors[detectorIndex];
+		for(std::size_t i = mNextScan++; i < scans.size(); i = mNextScan++){
+			detector.classifyScan(getScanView(*scans[i]), oDetections[i]);
+			mTotals[detectorIndex].add(detector.getStatistics());
+		}
+	}
+
+	std::vector<boost::shared_ptr<GDIFDetectorTree> > mDetectors;
+	std::vector<GDIFDetectorTotals> mTotals; ///< by detector
+	std::atomic<std::size_t> mNextScan;
+};
+
+struct RunStatistics{
+	RunStatistics() : mNumScans(0), mNumDetections(0), mFirstStamp(0.0), mLastStamp(0.0){}
+
+	uint64_t mNumScans;
+	uint64_t mNumDetections;
+	double mFirstStamp; ///< stamp of the first scan [s]
+	double mLastStamp; ///< stamp of the last scan [s]
+};
+
+/**
+ * detects in the scans of the batch, writes the detections in the order of the scans and clears the batch
+ */
+void processBatch(OfflineDetector& detector, std::vector<sensor_msgs::LaserScanConstPtr>& ioBatch,
+                  std::vector<std::vector<GDIFDetection> >& ioDetections, std::ostream& out, RunStatistics& ioStatistics){
+	if(ioBatch.empty())
+		return;
+	detector.detect(ioBatch, ioDetections);
+	for(uint i = 0; i < ioBatch.size(); ++i){
+		writeDetections(out, ioBatch[i]->header, ioStatistics.mNumScans + i, ioDetections[i]);
+		ioStatistics.mNumDetections += ioDetections[i].size();
+	}
+	if(ioStatistics.mNumScans == 0)
+		ioStatistics.mFirstStamp = ioBatch.front()->header.stamp.toSec();
+	ioStatistics.mLastStamp = ioBatch.back()->header.stamp.toSec();
+	ioStatistics.mNumScans += ioBatch.size();
+	ioBatch.clear();
+}
+
+int main(int argc, char** argv){
+	namespace po = boost::program_options;
+
+	std::vector<std::string> tBagFiles;
+	std::vector<std::string> tParamOverrides;
+	std::string tParamFile;
+	std::string tOutputFile;
+	std::string tTopic;
+	uint tNumThreads;
+	uint tBatchSize;
+
+	po::options_description tOptions("gandalf_offline_detector [options] bag files");
+	tOptions.add_options()
+		("help,h", "print this help")
+		("params,p", po::value<std::string>(&tParamFile)->required(), "rosparam YAML file of the detector, e.g. launch/stub_parameter.yaml")
+		("param,s", po::value<std::vector<std::string> >(&tParamOverrides), "overrides a parameter of the YAML file, e.g. -s JumpDistance=0.1")
+		("output,o", po::value<std::string>(&tOutputFile)->default_value("detections.txt"), "output file of the detections")
+		("topic,t", po::value<std::string>(&tTopic)->default_value("/laser"), "topic of the laser scans")
+		("threads,j", po::value<uint>(&tNumThreads)->default_value(std::max(boost::thread::hardware_concurrency(), 1u)), "number of threads")
+		("batch,b", po::value<uint>(&tBatchSize)->default_value(1000), "number of scans read before they are processed in parallel")
+		("bags", po::value<std::vector<std::string> >(&tBagFiles), "bag files");
+	po::positional_options_description tPositional;
+	tPositional.add("bags", -1);
+
+	try{
+		po::variables_map tVariables;
+		po::store(po::command_line_parser(argc, argv).options(tOptions).positional(tPositional).run(), tVariables);
+		if(tVariables.count("help") || !tVariables.count("bags")){
+			std::cout << tOptions << std::endl;
+			return tVariables.count("help") ? 0 : 1;
+		}
+		po::notify(tVariables);
+	}
+	catch(po::error const& e){
+		std::cerr << e.what() << std::endl << tOptions << std::endl;
+		return 1;
+	}
+
+	// only for the stamps of the messages, nothing waits for a clock
+	ros::Time::init();
+
+	DetectorNodeParams tParams;
+	try{
+		YamlParams tYamlParams(tParamFile);
+		for(uint i = 0; i < tParamOverrides.size(); ++i){
+			std::size_t tSeparator = tParamOverrides[i].find('=');
+			if(tSeparator == std::string::npos){
+				ROS_ERROR("invalid parameter [%s], expected Name=value", tParamOverrides[i].c_str());
+				return 1;
+			}
+			tYamlParams.setParam(tParamOverrides[i].substr(0, tSeparator), tParamOverrides[i].substr(tSeparator + 1));
+		}
+		readDetectorNodeParams(tYamlParams, tParams);
+	}
+	catch(YAML::Exception const& e){
+		ROS_ERROR("could not read parameter file [%s]: %s", tParamFile.c_str(), e.what());
+		return 1;
+	}
+	if(!tParams.getRootClassifierParams()){
+		ROS_ERROR("no classifier in parameter file [%s]", tParamFile.c_str());
+		return 1;
+	}
+	if(tParams.mBackgroundModelParams.mEnabled && tNumThreads > 1){
+		// the background model learns from the previous scans, so the scans have to be processed in order
+		ROS_WARN("the background model needs the scans in order, using one thread");
+		tNumThreads = 1;
+	}
+
+	std::ofstream tOutput(tOutputFile.c_str());
+	if(!tOutput){
+		ROS_ERROR("could not open output file [%s]", tOutputFile.c_str());
+		return 1;
+	}
+	writeDetectionFileHeader(tOutput);
+
+	OfflineDetector tDetector(tParams, tNumThreads);
+	std::vector<sensor_msgs::LaserScanConstPtr> tBatch;
+	std::vector<std::vector<GDIFDetection> > tDetections;
+	tBatch.reserve(tBatchSize);
+
+	RunStatistics tStatistics;
+	double tStartTime = ros::WallTime::now().toSec();
+
+	for(uint b = 0; b < tBagFiles.size(); ++b){
+		rosbag::Bag tBag;
+		try{
+			tBag.open(tBagFiles[b], rosbag::bagmode::Read);
+		}
+		catch(rosbag::BagException const& e){
+			ROS_ERROR("could not open bag file [%s]: %s", tBagFiles[b].c_str(), e.what());
+			return 1;
+		}
+		rosbag::View tView(tBag, rosbag::TopicQuery(tTopic));
+		for(rosbag::View::iterator it = tView.begin(); it != tView.end(); ++it){
+			sensor_msgs::LaserScanConstPtr tScan = it->instantiate<sensor_msgs::LaserScan>();
+			if(!tScan)
+				continue;
+			tBatch.push_back(tScan);
+			if(tBatch.size() >= std::max(tBatchSize, 1u))
+				processBatch(tDetector, tBatch, tDetections, tOutput, tStatistics);
+		}
+	}
+	processBatch(tDetector, tBatch, tDetections, tOutput, tStatistics);
+
+	double tDuration = ros::WallTime::now().toSec() - tStartTime;
+	ROS_INFO("%lu scans with %lu detections in %.3f s (%.1f scans/s, %.1f x the recorded time) with %u threads",
+	         (unsigned long)tStatistics.mNumScans, (unsigned long)tStatistics.mNumDetections, tDuration,
+	         tDuration > 0.0 ? tStatistics.mNumScans / tDuration : 0.0,
+	         tDuration > 0.0 ? (tStatistics.mLastStamp - tStatistics.mFirstStamp) / tDuration : 0.0, tNumThreads);
+	GDIFDetectorTotals tTotals = tDetector.getTotals();
+	ROS_INFO("%lu segments, %lu too small, %lu of invalid beams, %lu candidates, %lu out of range, %lu outside of the regions of interest, "
+	         "%lu on the background, %lu pre-filtered, %lu invalid boxes, %lu skipped, %lu classified",
+	         (unsigned long)tTotals.mSegments, (unsigned long)tTotals.mSmallSegments, (unsigned long)tTotals.mInvalidBeamSegments,
+	         (unsigned long)tTotals.mCandidates, (unsigned long)tTotals.mOutOfRange, (unsigned long)tTotals.mOutsideRegionsOfInterest,
+	         (unsigned long)tTotals.mBackgroundRejected, (unsigned long)tTotals.mPreFilterRejected, (unsigned long)tTotals.mInvalidBoxes,
+	         (unsigned long)tTotals.mSkippedCandidates, (unsigned long)tTotals.mClassified);
+	for(uint n = 0; n < tTotals.mNodeEvaluations.size(); ++n){
+		ROS_INFO("node %u evaluated for %lu candidates", n, (unsigned long)tTotals.mNodeEvaluations[n]);
+	}
+	return 0;
+}